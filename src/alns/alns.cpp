@@ -52,7 +52,10 @@ void (*insertions[INSERT_COUNT])(Solution &solution) {
         [N3_MOST_EXCLUSIONS_INSERT] = n3_most_exclusions_insert,
         [N3_LEAST_EXCLUSIONS_INSERT] = n3_least_exclusions_insert,
         [N3_MOST_USED_INSERT] = n3_most_used_insert,
-        [N3_LEAST_USED_INSERT] = n3_least_used_insert
+        [N3_LEAST_USED_INSERT] = n3_least_used_insert,
+
+        [REGRET2_INSERT] = regret2_insert,
+        [REGRET3_INSERT] = regret3_insert
 };
 
 void (*removals[REMOVE_COUNT])(Solution &solution) {
@@ -69,6 +72,14 @@ void (*removals[REMOVE_COUNT])(Solution &solution) {
         [LEAST_USED_REMOVE] = least_used_remove
 };
 
+void (*batch_removals[REMOVE_COUNT])(Solution &solution, uint_t count) {
+        [RANDOM_REMOVE] = nullptr,
+        [CHEAPEST_REMOVE] = cheapest_batch_remove,
+        [MOST_EXPENSIVE_REMOVE] = most_expensive_batch_remove,
+        [LRD_REMOVE] = lrd_batch_remove,
+        [HRD_REMOVE] = hrd_batch_remove
+};
+
 Solution (*constructions[CONSTRUCTION_COUNT])(Instance *instance, std::default_random_engine *engine) {
         [RANDOM_CONSTRUCT] = random_construct,
         [LONGEST1_CONSTRUCT] = longest1_construct,
@@ -110,8 +121,11 @@ double ALNS::compute_destroy_method_probability(uint_t idx) {
 bool ALNS::iteration() {
     bool improved = false;
 
+    /* current solution is changed in place, rejected changes are rolled back by its undo trail */
 //    cur_sol_mutex.lock();
-    Solution solution_ = cur_solution;
+    Solution &solution_ = cur_solution;
+    fitness_t cur_cost = cur_solution.extended_objective;
+    solution_.checkpoint();
 //    cur_sol_mutex.unlock();
 
     /* select destroy and repair methods (indices to vectors in ALNS) */
@@ -121,8 +135,15 @@ bool ALNS::iteration() {
     uniform_int_distribution<int> count(1, ub);
 
     /* destroy temporary solution with randomly selected destroy method */
-    for (uint_t i = 0; i < count(alns_engine); ++i) {
-        (*(this->destroy_methods[d_idx]))(solution_);
+    if (this->batch_destroy_methods[d_idx]) {
+        /* batch methods do not draw random numbers, so the count is drawn the same way as when removing one by one */
+        uint_t removals_count = 0;
+        while (removals_count < count(alns_engine)) removals_count++;
+        (*(this->batch_destroy_methods[d_idx]))(solution_, removals_count);
+    } else {
+        for (uint_t i = 0; i < count(alns_engine); ++i) {
+            (*(this->destroy_methods[d_idx]))(solution_);
+        }
     }
 
     /* repair temporary solution with randomly selected repair method */
@@ -142,23 +163,30 @@ bool ALNS::iteration() {
     double omega_2 = 0;
     double omega_3 = 0;
     double omega_4 = 0;
-    if (best_solution.extended_objective - solution_.extended_objective > ACCEPT_TOLERANCE) { // better than global best
-        best_solution = solution_;
+    bool best_improved = best_solution.extended_objective - solution_.extended_objective > ACCEPT_TOLERANCE;
+    if (best_improved) { // better than global best
+        /* replaying the changes is cheaper than copying the whole solution */
+        if (this->best_follows) best_solution.follow(solution_);
+        else best_solution = solution_;
+        best_solution.release();
         omega_1 = OMEGA_1;
     }
 
 //    cur_sol_mutex.lock();
-    if (cur_solution.extended_objective - solution_.extended_objective > ACCEPT_TOLERANCE) { // better than current & accepted
-        cur_solution = solution_;
+    if (cur_cost - solution_.extended_objective > ACCEPT_TOLERANCE) { // better than current & accepted
         improved = true;
         omega_2 = OMEGA_2;
+        this->best_follows = best_improved;
     }
 //    if (accept_solution(cur_solution.extended_objective, solution_.extended_objective)) { // accepted
 //        omega_3 = OMEGA_3;
 //    }
     else { // rejected
+        solution_.rollback();
         omega_4 = OMEGA_4;
+        if (best_improved) this->best_follows = false;
     }
+    solution_.release();
 //    cur_sol_mutex.unlock();
 
     this->adjust_weights(r_idx, d_idx, this->get_psi(omega_1, omega_2, omega_3, omega_4));
@@ -188,7 +216,7 @@ ALNS::ALNS(Instance *instance, int seed) {
             this->add_repair_method(insertions[i], insertions_labels[i]);
     for (int i = 0; i < REMOVE_COUNT; ++i)
         if (methods.removals[i])
-            this->add_destroy_method(removals[i], removals_labels[i]);
+            this->add_destroy_method(removals[i], removals_labels[i], batch_removals[i]);
     for (int i = 0; i < LS_COUNT; ++i) if (methods.ls[i]) this->add_ls_operator(ls[i], ls_labels[i]);
     this->add_construction(constructions[methods.construction], constructions_labels[methods.construction]);
     /* set initial weight for each method and add it to sum */
@@ -198,6 +226,8 @@ ALNS::ALNS(Instance *instance, int seed) {
     this->destroy_weights = vector<double>(this->destroy_methods.size(), INITIAL_WEIGHT);
     this->destroy_weights_sum = this->destroy_methods.size() * INITIAL_WEIGHT;
     this->restarts_cnt = 0;
+    this->pool = nullptr;
+    this->pool_version = 0;
 #if VERBOSE_CONFIG
     this->dump_methods();
 #endif
@@ -281,6 +311,7 @@ Solution ALNS::greedy_search() {
 //    cur_sol_mutex.lock();
     cur_solution = init_solution;
     best_solution = cur_solution;
+    best_follows = true;
 //    cur_sol_mutex.unlock();
 
 //    thread ls_thread(&ALNS::parallel_local_search, this);
@@ -288,10 +319,16 @@ Solution ALNS::greedy_search() {
     restarts_cnt = 0;
     accept_temperature = 0;
     uint_t iter_cnt = 0;
+    uint_t migration_cnt = 0;
+    fitness_t offered = numeric_limits<fitness_t>::max(); /* objective of the last solution offered to the pool */
 
     while (!stop()) {
         if (this->iteration()) {
             iter_cnt = 0;
+            if (this->pool && offered - best_solution.extended_objective > ACCEPT_TOLERANCE) {
+                this->pool->offer(best_solution);
+                offered = best_solution.extended_objective;
+            }
 #if SAVE_SOL_PROGRESS
             string progress_output = SOL_PROGRESS_DIR + to_string(++sol_progress_cnt) + ".txt";
             cout << progress_output << endl;
@@ -300,6 +337,10 @@ Solution ALNS::greedy_search() {
         } else {
             iter_cnt++;
         }
+        if (this->pool && ++migration_cnt == MIGRATION_PERIOD) {
+            migration_cnt = 0;
+            this->migrate();
+        }
 
 #if VERBOSE_ALNS
         cerr << "ITERATION" << endl;
@@ -317,6 +358,7 @@ Solution ALNS::greedy_search() {
             } else { // Other constructions are assumed to be deterministic
                 cur_solution = init_solution;
             }
+            best_follows = false;
 //            cur_sol_mutex.unlock();
         }
     }
@@ -330,16 +372,104 @@ Solution ALNS::greedy_search() {
 //    cur_sol_mutex.unlock();
 
     best_solution.restarts_cnt = restarts_cnt;
+    if (this->pool) this->pool->offer(best_solution);
     return best_solution;
 }
 
+void ALNS::migrate() {
+    ullint_t version = this->pool->get_version();
+    if (version == this->pool_version) return;
+    this->pool_version = version;
+    Solution elite = this->pool->get_best();
+    /* random choices of the worker have to stay on its own engine */
+    elite.engine = &this->alns_engine;
+    bool best_adopted = best_solution.extended_objective - elite.extended_objective > ACCEPT_TOLERANCE;
+    if (best_adopted) {
+        best_solution = elite;
+        best_follows = false;
+    }
+    if (cur_solution.extended_objective - elite.extended_objective > ACCEPT_TOLERANCE) {
+        cur_solution = elite;
+        best_follows = best_adopted;
+    }
+}
+
+void ALNS::set_pool(ElitePool *pool) {
+    this->pool = pool;
+}
+
+uint_t ALNS::get_restarts_cnt() {
+    return this->restarts_cnt;
+}
+
+ElitePool::ElitePool() {
+    this->threshold = numeric_limits<fitness_t>::max();
+    this->version = 0;
+}
+
+bool ElitePool::offer(const Solution &solution) {
+    if (this->threshold - solution.extended_objective <= ACCEPT_TOLERANCE) return false;
+    lock_guard<std::mutex> lock(this->pool_mutex);
+    /* the same solution is often offered again by the worker that found it */
+    for (const Solution &elite : this->solutions) {
+        if (fabs(elite.extended_objective - solution.extended_objective) <= ACCEPT_TOLERANCE) return false;
+    }
+    auto it = this->solutions.begin();
+    while (it != this->solutions.end() && it->extended_objective < solution.extended_objective) ++it;
+    bool best = it == this->solutions.begin();
+    this->solutions.insert(it, solution);
+    if (this->solutions.size() > ELITE_SIZE) this->solutions.pop_back();
+    if (this->solutions.size() == ELITE_SIZE) this->threshold = this->solutions.back().extended_objective;
+    if (best) this->version++;
+    return best;
+}
+
+ullint_t ElitePool::get_version() {
+    return this->version;
+}
+
+Solution ElitePool::get_best() {
+    lock_guard<std::mutex> lock(this->pool_mutex);
+    return this->solutions.front();
+}
+
+uint_t ElitePool::size() {
+    lock_guard<std::mutex> lock(this->pool_mutex);
+    return this->solutions.size();
+}
+
+Solution parallel_greedy_search(Instance *instance, int seed, uint_t threads) {
+    ElitePool pool;
+    vector<unique_ptr<ALNS>> workers;
+    /* workers are set up one after another as the setup of methods is global, each gets its own stream of random numbers */
+    seed_seq sequence{seed};
+    vector<uint32_t> seeds(threads);
+    sequence.generate(seeds.begin(), seeds.end());
+    for (uint_t w = 0; w < threads; ++w) {
+        workers.emplace_back(new ALNS(instance, (int) seeds[w]));
+        workers[w]->set_pool(&pool);
+    }
+    uint_t restarts = 0;
+    /* local search of each worker runs sequentially inside the team unless nested parallelism is enabled */
+    #pragma omp parallel for num_threads(threads) schedule(static, 1) reduction(+:restarts)
+    for (uint_t w = 0; w < threads; ++w) {
+        workers[w]->greedy_search();
+        restarts += workers[w]->get_restarts_cnt();
+    }
+    Solution best = pool.get_best();
+    best.engine = nullptr;
+    best.restarts_cnt = restarts;
+    return best;
+}
+
 void ALNS::add_repair_method(func_t method, string method_name) {
     this->repair_methods.push_back(method);
     this->repair_methods_names[method] = method_name;
 }
 
-void ALNS::add_destroy_method(func_t method, string method_name) {
+void ALNS::add_destroy_method(func_t method, string method_name, batch_t batch) {
     this->destroy_methods.push_back(method);
+    this->batch_destroy_methods.push_back(batch);
     this->destroy_methods_names[method] = method_name;
 }
 
@@ -10,16 +10,37 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <memory>
+#include <omp.h>
 #include "../solution/solution.hpp"
 #include "../insertions/insertions.hpp"
 #include "../removals/removals.hpp"
 #include "../types.hpp"
 #include "../params.hpp"
 
+#define ELITE_SIZE 8 /* number of best solutions kept in the pool shared by parallel workers */
+#define MIGRATION_PERIOD 50 /* iterations of a worker between checks for a new best solution in the pool */
+
 using namespace std;
 
+/* best solutions found by parallel ALNS workers sorted from the best one, workers offer their improvements and adopt new bests */
+class ElitePool {
+    private:
+        std::mutex pool_mutex;
+        vector<Solution> solutions;
+        atomic<fitness_t> threshold; /* objective a solution has to beat to enter the pool, read without locking */
+        atomic<ullint_t> version; /* incremented whenever the best solution changes */
+    public:
+        ElitePool();
+        bool offer(const Solution &solution); /* adds copy of the solution if it is good enough, returns true for a new best */
+        ullint_t get_version();
+        Solution get_best();
+        uint_t size();
+};
+
 typedef void (*func_t) (Solution &solution);
 typedef bool (*operator_t) (Solution &solution);
+typedef void (*batch_t) (Solution &solution, uint_t count);
 typedef Solution(*cons_t) (Instance *instance, std::default_random_engine *engine);
 
 typedef unordered_map<func_t, string> func_to_name_t;
@@ -33,6 +54,9 @@ class ALNS {
         std::default_random_engine ls_engine;
         Solution cur_solution;  // best in current restart, initial solution in every iteration
         Solution best_solution; // best over all restarts
+        bool best_follows; // best solution equals the current one, so it can follow changes of the current one
+        ElitePool *pool; // shared with other workers, null when searching alone
+        ullint_t pool_version; // version of the pool when it was checked last time
         uniform_real_distribution<double> range;
         std::mutex cur_sol_mutex;
 
@@ -40,6 +64,7 @@ class ALNS {
         func_to_name_t repair_methods_names;
         vector<func_t> destroy_methods; /* pointers to methods used to destroy solution */
         func_to_name_t destroy_methods_names;
+        vector<batch_t> batch_destroy_methods; /* versions of destroy methods removing more interventions at once, null if there is none */
         vector<operator_t> ls_operators;
         op_to_name_t ls_operators_names;
         cons_t construction;
@@ -57,6 +82,7 @@ class ALNS {
         double compute_repair_method_probability(uint_t idx); /* compute probability of selecting repair method on index idx based on its weight */
         double compute_destroy_method_probability(uint_t idx); /* compute probability of selecting destroy method on index idx based on its weight */
         bool iteration(); /* one iteration of the search */
+        void migrate(); /* adopts the best solution of the pool if it is better than the current one */
     public:
 //        ALNS(Solution *solution);
         ALNS(Instance *instance, int seed);
@@ -65,8 +91,10 @@ class ALNS {
         uint_t select_repair_idx(); /* randomly selects repair method considering probabilities computed from weights */
         uint_t select_destroy_idx(); /* randomly selects destroy method considering probabilities computed from weights */
         Solution greedy_search(); /* search neigborhood */
+        void set_pool(ElitePool *pool);
+        uint_t get_restarts_cnt();
         void add_repair_method(func_t method, string method_name);
-        void add_destroy_method(func_t method, string method_name);
+        void add_destroy_method(func_t method, string method_name, batch_t batch = nullptr);
         void add_ls_operator(operator_t op, string op_name);
         string get_repair_name(func_t method);
         string get_destroy_name(func_t method);
@@ -80,4 +108,7 @@ class ALNS {
         void parallel_local_search();
 };
 
+/* runs greedy_search of independent workers on all threads, returns the best solution found by any of them */
+Solution parallel_greedy_search(Instance *instance, int seed, uint_t threads);
+
 #endif
@@ -5,16 +5,21 @@
  * Parameter nu adds additive noise to cost_insert = (1 + nu) * cost; cost = cost(after) - cost(before).
  * Returns tuple<cheapest_t, best_cost, objective>, where cheapest_t and best cost are "noisy" values and objective is exact
  */
-tuple<uint_t, fitness_t, Objective> get_cheapest_time(Solution &sol, uint_t i, fitness_t nu) {
+tuple<uint_t, fitness_t, Objective> get_cheapest_time(Solution &sol, uint_t i, fitness_t nu, std::default_random_engine *engine) {
     uint_t cheapest_t;
     fitness_t cost;
     fitness_t best_cost = numeric_limits<fitness_t>::max();
-    Objective o;
     Objective best_o;
     uniform_real_distribution<fitness_t> dist(0, nu);
+    if (!engine) engine = sol.engine;
+    /* estimates of all start times are evaluated at once and cached in the solution, buffer is kept per thread */
+    static thread_local vector<Objective> objectives;
+    sol.estimate_schedule_times_cached(i, objectives);
     for (uint_t t = 1; t <= sol.instance->get_t_max(i); ++t) {
-        o = sol.estimate_schedule(i, t);
-        cost = (1 + dist(*sol.engine)) * (o.extended_objective - sol.extended_objective);
+        const Objective &o = objectives[t];
+        cost = o.extended_objective - sol.extended_objective;
+        /* exact heuristics draw no noise */
+        if (nu > 0) cost *= 1 + dist(*engine);
         if (best_cost - cost > ACCEPT_TOLERANCE) {
             best_cost = cost;
             cheapest_t = t;
@@ -41,9 +46,23 @@ void property_at_cheapest_time_based_insert(Solution &solution, fitness_t nu, fi
     vector<tuple_t> property_tuples(size);
     vector<fitness_t> probabilities(size);
 
+    /*
+     * candidates are evaluated in parallel, each with its own engine seeded by its intervention,
+     * so the choice depends neither on the number of threads nor on their scheduling
+     */
+    vector<tuple<uint_t, fitness_t, Objective>> cheapest(size);
+    uint_t seed = nu > 0 ? (*solution.engine)() : 0;
+    solution.prepare_cache();
+    #pragma omp parallel for schedule(dynamic)
+    for (int idx = 0; idx < size; ++idx) {
+        std::seed_seq sequence{seed, subset[idx]};
+        std::default_random_engine engine(sequence);
+        cheapest[idx] = get_cheapest_time(solution, subset[idx], nu, &engine);
+    }
+
     for (uint_t i : subset) {
 //    for (uint_t i : solution.unscheduled) {
-            auto p = get_cheapest_time(solution, i, nu);
+        auto &p = cheapest[id];
         if (property == "length") {
             property_tuples[id] = tuple_t (solution.instance->delta[solution.instance->get_delta_index(i, get<0>(p))], i, get<0>(p)); // property = length, intervention, start time
         } else if (property == "cost") {
@@ -158,12 +177,12 @@ void lrd2_insert(Solution &solution) {
     fitness_t lowest_increase;
     fitness_t lowest_increase_overall = numeric_limits<fitness_t>::max();
     fitness_t increase;
-    Objective o;
+    vector<Objective> objectives;
     for (uint_t ui : solution.unscheduled) {
         lowest_increase = numeric_limits<fitness_t>::max();
+        solution.estimate_schedule_times_cached(ui, objectives);
         for (uint_t uut = 1; uut <= solution.instance->get_t_max(ui); ++uut) {
-            o = solution.estimate_schedule(ui, uut);
-            increase = o.total_resource_use - solution.total_resource_use;
+            increase = objectives[uut].total_resource_use - solution.total_resource_use;
             if (increase + ACCEPT_TOLERANCE < lowest_increase) {
                 ut = uut;
                 lowest_increase = increase;
@@ -191,7 +210,7 @@ void longest2_insert(Solution &solution) {
     uint_t max_length = 0;
     uint_t cur_min_length;
     uint_t length;
-    uint_t delta_idx;
+    ullint_t delta_idx;
 
     // for all interventions
     for (uint_t i : solution.unscheduled) {
@@ -228,7 +247,7 @@ void shortest2_insert(Solution &solution) {
     uint_t t_final;
     uint_t length_min = numeric_limits<uint_t>::max();
     uint_t length_cur;
-    uint_t delta_idx;
+    ullint_t delta_idx;
 
     // for all interventions
     for (uint_t i : solution.unscheduled) {
@@ -282,7 +301,7 @@ vector<uint_t> get_unscheduled_subset(Solution &solution, const string& property
 
     for (auto p:avg_properties) {
         auto i = p.first;
-        if (solution.unscheduled.find(i) != solution.unscheduled.end()) { // i is unscheduled
+        if (!solution.is_scheduled(i)) { // i is unscheduled
             subset.push_back(i);
             cnt++;
         }
@@ -299,13 +318,13 @@ void random_with_me_violations(Solution &solution) {
     std::advance(it, range(*solution.engine));
     uint_t i = *it;
     // Select t with highest exclusion penalty
-    Objective o;
+    vector<Objective> objectives;
     uint_t max_e_penalty = 0;
     uint_t max_t = 1;
+    solution.estimate_schedule_times_cached(i, objectives);
     for (uint_t t = 1; t <= solution.instance->get_t_max(i); ++t) {
-        o = solution.estimate_schedule(i, t);
-        if (o.exclusion_penalty > max_e_penalty) {
-            max_e_penalty = o.exclusion_penalty;
+        if (objectives[t].exclusion_penalty > max_e_penalty) {
+            max_e_penalty = objectives[t].exclusion_penalty;
             max_t = t;
         }
     }
@@ -313,4 +332,47 @@ void random_with_me_violations(Solution &solution) {
     solution.schedule(i, max_t);
 }
 
+/*
+ * For each unscheduled intervention, determine costs of its k cheapest start times from cached estimates.
+ * Regret is the sum of differences between the cheapest start time and the other k - 1 ones,
+ * intervention with the highest regret is scheduled to its cheapest start time,
+ * interventions with less than k start times have infinite regret
+ */
+void regret_insert(Solution &solution, uint_t k) {
+    uint_t i;
+    uint_t t;
+    uint_t count;
+    fitness_t regret;
+    fitness_t highest_regret = -numeric_limits<fitness_t>::max();
+    fitness_t cost;
+    static thread_local vector<Objective> objectives;
+    vector<pair<fitness_t, uint_t>> cheapest(k); /* costs and start times of k cheapest start times sorted from the cheapest */
+    for (uint_t ui : solution.unscheduled) {
+        count = 0;
+        solution.estimate_schedule_times_cached(ui, objectives);
+        for (uint_t ut = 1; ut <= solution.instance->get_t_max(ui); ++ut) {
+            cost = objectives[ut].extended_objective - solution.extended_objective;
+            if (count == k && cost + ACCEPT_TOLERANCE >= cheapest[k - 1].first) continue;
+            uint_t pos = count < k ? count++ : k - 1;
+            while (pos > 0 && cheapest[pos - 1].first > cost + ACCEPT_TOLERANCE) {
+                cheapest[pos] = cheapest[pos - 1];
+                pos--;
+            }
+            cheapest[pos] = make_pair(cost, ut);
+        }
+        regret = 0.0;
+        if (count < k) regret = numeric_limits<fitness_t>::max();
+        else for (uint_t j = 1; j < k; ++j) regret += cheapest[j].first - cheapest[0].first;
+        if (regret > highest_regret + ACCEPT_TOLERANCE) {
+            i = ui;
+            t = cheapest[0].second;
+            highest_regret = regret;
+        }
+    }
+
+    #if VERBOSE_HEURISTICS
+    cerr << "REGRET_INSERT(k = " << k << "): scheduled intervention " << solution.instance->get_intervention(i) << " at time " << t << ", regret = " << highest_regret << endl;
+    #endif
 
+    solution.schedule(i, t);
+}
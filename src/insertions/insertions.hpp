@@ -6,6 +6,8 @@
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <random>
+#include <omp.h>
 #include "../instance/instance.hpp"
 #include "../solution/solution.hpp"
 #include "../types.hpp"
@@ -13,7 +15,8 @@
 
 using namespace std;
 
-tuple<uint_t, fitness_t, Objective> get_cheapest_time(Solution &sol, uint_t i, fitness_t nu);
+/* noise is drawn from the engine of the solution unless another one is given */
+tuple<uint_t, fitness_t, Objective> get_cheapest_time(Solution &sol, uint_t i, fitness_t nu, std::default_random_engine *engine = nullptr);
 
 // Both intervention and start time selection randomized
 void property_at_cheapest_time_based_insert(Solution &solution, fitness_t nu, fitness_t mu, const string& property);
@@ -87,6 +90,11 @@ void shortest2_insert(Solution &solution);
 
 void random_with_me_violations(Solution &solution);
 
+// Regret heuristics - intervention losing the most by not getting its cheapest start time is scheduled first
+void regret_insert(Solution &solution, uint_t k);
+inline void regret2_insert(Solution &solution) {regret_insert(solution, 2);}
+inline void regret3_insert(Solution &solution) {regret_insert(solution, 3);}
+
 vector<uint_t> get_unscheduled_subset(Solution &solution, const string& property, fitness_t mu);
 
 #endif //ROADEF_INSERTIONS_H
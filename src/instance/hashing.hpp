@@ -41,10 +41,10 @@ namespace hashing {
 
 }
 
-/* overloads for eqality functions for pair and quad keys*/
-namespace std {
-    bool operator==(const hashing::pair_key &first, const hashing::pair_key &second);
-    bool operator==(const hashing::quad_key &first, const hashing::quad_key &second);
+/* overloads for eqality functions for pair and quad keys (in key namespace to be found by argument dependent lookup) */
+namespace hashing {
+    bool operator==(const pair_key &first, const pair_key &second);
+    bool operator==(const quad_key &first, const quad_key &second);
 }
 
 #endif
@@ -10,38 +10,51 @@ void Instance::add_exclusion_pair_to_season_horizons(uint_t id1, uint_t id2, uin
 }
 
 /* constructor */
-Instance::Instance() {
-    /* set size of of exlusion 2d vector to maximal horizon size (specific value not known in compile time) */
-    this->time_exclusions.resize(MAX_HORIZONS);
-    this->exclusions_by_interventions.resize(MAX_INTERVENTIONS);
-}
+Instance::Instance() {}
 
 /* destructor */
 Instance::~Instance() {
     delete[] this->u;
     delete[] this->l;
     delete[] this->delta;
-    delete[] this->r;
-    delete[] this->risk;
 }
 
+/* products are computed in 64 bits, the exclusion tables are sized by the instance as well */
 void Instance::prepare_products(uint_t i, uint_t r, uint_t t) {
-    this->rxt = r * t;
-    this->ixt = i * t;
-    this->ixt_ = i * t;
-    this->ixt_xt = i * t * t;
-    this->ixt_xr = i * t * r;
-    this->ixt_xrxt = i * t * r * t;
-    this->t_xrxt = t * r * t;
-    this->t_xt = t * t;
+    this->rxt = (ullint_t)r * t;
+    this->ixt = (ullint_t)i * t;
+    this->ixr = (ullint_t)i * r;
+    this->ixt_ = (ullint_t)i * t;
+    this->ixt_xr = (ullint_t)i * t * r;
+    this->resource_num = r;
+    this->time_exclusions.assign(t, uint_vector_t());
+    this->exclusions_by_interventions.assign(i + 1, uint_vector_t());
 }
 
 void Instance::allocate_arrays() {
     this->u = new fitness_t[this->rxt];
     this->l = new fitness_t[this->rxt];
     this->delta = new uint_t[this->ixt];
-    this->r = new half_fitness_t[this->ixt_xrxt];
-    this->risk = new half_fitness_vector_t[this->ixt_xt];
+    this->r_offsets.resize(this->ixt_, 0);
+    this->resource_positions.resize(this->ixr, 0);
+    this->risk_offsets.resize(this->ixt_, 0);
+    /* prefix sums of scenarios to locate rows inside risk blocks */
+    this->scenario_offsets.resize(this->horizon_num + 1, 0);
+    for (uint_t t = 1; t <= this->horizon_num; ++t) {
+        this->scenario_offsets[t] = this->scenario_offsets[TO_INDEX(t)] + this->get_scenarios(t);
+    }
+    /* kernels are chosen once per horizon, evaluation parameters are already known */
+    this->quantile_indices.resize(this->horizon_num, 0);
+    this->scenario_kernels.resize(this->horizon_num, 0);
+    for (uint_t t = 1; t <= this->horizon_num; ++t) {
+        uint_t scenarios = this->get_scenarios(t);
+        this->quantile_indices[TO_INDEX(t)] = ceil(scenarios * this->quantile);
+        this->scenario_kernels[TO_INDEX(t)] = scenarios <= SMALL_SCENARIOS ? scenarios : 0;
+    }
+#ifdef REDUCED_PRECISION
+    this->reference_objectives.assign(this->ixt, 0.0);
+    this->reference_resource_uses.assign(this->ixt, 0.0);
+#endif
 }
 
 /*
@@ -147,6 +160,18 @@ uint_t Instance::get_max_scenarios() {
     return max;
 }
 
+ullint_t Instance::get_scenario_offset(uint_t horizon) const {
+    return this->scenario_offsets[TO_INDEX(horizon)];
+}
+
+uint_t Instance::get_quantile_index(uint_t horizon) const {
+    return this->quantile_indices[TO_INDEX(horizon)];
+}
+
+uint_t Instance::get_scenario_kernel(uint_t horizon) const {
+    return this->scenario_kernels[TO_INDEX(horizon)];
+}
+
 /* sets evaluation paramters */
 void Instance::set_eval_parameters(fitness_t quantile, fitness_t alpha, uint_t comp_time) {
     this->quantile = quantile;
@@ -197,19 +222,15 @@ void Instance::add_exclusion(uint_t intervention1, uint_t intervention2, uint_t
 }
 
 /* gets vector that contains times where two passed interventions cannot be conducted at once */
-uint_vector_t Instance::get_exclusion_season(string intervention1, string intervention2) {
-    uint_t id1 = this->get_intervention_id(intervention1);
-    uint_t id2 = this->get_intervention_id(intervention2);
-    // sort pair to be in format {smaller, larger}
-    struct pair_key key = (id1 < id2) ? (struct pair_key){id1, id2} : (struct pair_key){id2, id1};
-    return this->seasons[this->exclusion_seasons[key]];
+const uint_vector_t &Instance::get_exclusion_season(string intervention1, string intervention2) {
+    return this->get_exclusion_season(this->get_intervention_id(intervention1), this->get_intervention_id(intervention2));
 }
 
-/* gets vector that contains times where two passed interventions cannot be conducted at once */
-uint_vector_t Instance::get_exclusion_season(uint_t intervetion1, uint_t intervention2) {
+/* gets vector that contains times where two passed interventions cannot be conducted at once (by reference, it is read on hot path) */
+const uint_vector_t &Instance::get_exclusion_season(uint_t intervetion1, uint_t intervention2) const {
     // sort pair to be in format {smaller, larger}
     struct pair_key key = (intervetion1 < intervention2) ? (struct pair_key){intervetion1, intervention2} : (struct pair_key){intervention2, intervetion1};
-    return this->seasons[this->exclusion_seasons[key]];
+    return this->seasons[this->exclusion_seasons.at(key)];
 }
 
 /* get vector of pairs of interventions that are excluded in passed time_horizon */
@@ -229,45 +250,330 @@ const uint_vector_t &Instance::get_excluded(uint_t intervention) const {
     return this->exclusions_by_interventions[intervention];
 }
 
+/* partners keep the order in which exclusions were added */
+void Instance::compile_exclusions() {
+    this->exclusion_offsets.assign(this->intervention_count + 1, 0);
+    this->exclusion_partners.clear();
+    this->exclusion_partner_seasons.clear();
+    for (uint_t intervention = 1; intervention < this->intervention_count; ++intervention) {
+        this->exclusion_offsets[intervention] = this->exclusion_partners.size();
+        for (uint_t e : this->exclusions_by_interventions[intervention]) {
+            struct pair_key key = (intervention < e) ? (struct pair_key){intervention, e} : (struct pair_key){e, intervention};
+            this->exclusion_partners.push_back(e);
+            this->exclusion_partner_seasons.push_back(this->exclusion_seasons.at(key));
+        }
+    }
+    this->exclusion_offsets[this->intervention_count] = this->exclusion_partners.size();
+    this->season_prefixes.assign(this->seasons.size() * (this->horizon_num + 1), 0);
+    for (uint_t season = 0; season < this->seasons.size(); ++season) {
+        uint_t *prefix = this->season_prefixes.data() + season * (this->horizon_num + 1);
+        for (uint_t horizon : this->seasons[season]) {
+            if (horizon >= 1 && horizon <= this->horizon_num) prefix[horizon]++;
+        }
+        for (uint_t t = 1; t <= this->horizon_num; ++t) prefix[t] += prefix[TO_INDEX(t)];
+    }
+}
+
+uint_t Instance::get_exclusion_begin(uint_t intervention) const {
+    return this->exclusion_offsets[intervention];
+}
+
+uint_t Instance::get_exclusion_end(uint_t intervention) const {
+    return this->exclusion_offsets[intervention + 1];
+}
+
+uint_t Instance::get_exclusion_partner(uint_t item) const {
+    return this->exclusion_partners[item];
+}
+
+uint_t Instance::get_exclusion_season_id(uint_t item) const {
+    return this->exclusion_partner_seasons[item];
+}
+
+const uint_vector_t &Instance::get_season(uint_t season) const {
+    return this->seasons[season];
+}
+
+uint_t Instance::count_season_overlap(uint_t season, uint_t start1, uint_t end1, uint_t start2, uint_t end2) const {
+    uint_t from = std::max(start1, start2);
+    uint_t to = std::min(std::min(end1, end2), this->horizon_num + 1);
+    if (from >= to) return 0;
+    const uint_t *prefix = this->season_prefixes.data() + season * (this->horizon_num + 1);
+    return prefix[TO_INDEX(to)] - prefix[TO_INDEX(from)];
+}
+
 const uint_set_t &Instance::get_interventions_with_exclusions() const {
     return this->interventions_with_exclusions;
 }
 
-uint_t Instance::get_ul_index(string resource, uint_t horizon) {
-    return TO_INDEX(this->get_resource_id(resource)) * this->horizon_num + TO_INDEX(horizon);
+ullint_t Instance::get_ul_index(string resource, uint_t horizon) {
+    return this->get_ul_index(this->get_resource_id(resource), horizon);
 }
 
-uint_t Instance::get_ul_index(uint_t resource, uint_t horizon) {
-    return TO_INDEX(resource) * this->horizon_num + TO_INDEX(horizon);
+ullint_t Instance::get_ul_index(uint_t resource, uint_t horizon) const {
+    return (ullint_t)TO_INDEX(resource) * this->horizon_num + TO_INDEX(horizon);
 }
 
-uint_t Instance::get_delta_index(string intervention, uint_t horizon) {
-    return TO_INDEX(this->get_intervention_id(intervention)) * this->horizon_num + TO_INDEX(horizon);
+ullint_t Instance::get_delta_index(string intervention, uint_t horizon) {
+    return this->get_delta_index(this->get_intervention_id(intervention), horizon);
 }
 
-uint_t Instance::get_delta_index(uint_t intervention, uint_t horizon) {
-    return TO_INDEX(intervention) * this->horizon_num + TO_INDEX(horizon);
+ullint_t Instance::get_delta_index(uint_t intervention, uint_t horizon) const {
+    return (ullint_t)TO_INDEX(intervention) * this->horizon_num + TO_INDEX(horizon);
 }
 
-void Instance::add_r(uint_t intervention, uint_t resource, uint_t index, half_fitness_t r) {
+void Instance::add_intervention_resource(uint_t intervention, uint_t resource) {
     this->resources_used_by_intervention[TO_INDEX(intervention)].insert(resource);
-    this->r[index] = r;
 }
 
-uint_t Instance::get_r_index(string intervention, uint_t start_horizon, string resource, uint_t horizon) {
-    return TO_INDEX(this->get_intervention_id(intervention)) * this->t_xrxt + TO_INDEX(start_horizon) * this->rxt + TO_INDEX(this->get_resource_id(resource)) * this->horizon_num + TO_INDEX(horizon);
+/*
+ * appends window block for each start time of the intervention to the end of r
+ * block of start time t' holds delta(i, t') workloads for each used resource, start times after t_max get empty blocks
+ */
+void Instance::allocate_r_windows(uint_t intervention) {
+    uint_t position = 0;
+    for (uint_t resource : this->get_interventions_resources(intervention)) {
+        this->resource_positions[(ullint_t)TO_INDEX(intervention) * this->resource_num + TO_INDEX(resource)] = position++;
+    }
+    ullint_t delta_idx = this->get_delta_index(intervention, 1);
+    ullint_t size = this->r.size();
+    for (uint_t start = 1; start <= this->horizon_num; ++start) {
+        this->r_offsets[delta_idx] = size;
+        if (start <= this->get_t_max(intervention)) size += (ullint_t)position * this->delta[delta_idx];
+        delta_idx++;
+    }
+    this->r.resize(size, 0.0);
+}
+
+void Instance::add_r(uint_t intervention, uint_t start_horizon, uint_t resource, uint_t horizon, fitness_t r) {
+    if (!this->in_window(intervention, start_horizon, horizon)) return;
+    this->r[this->get_r_index(intervention, start_horizon, resource, horizon)] = (half_fitness_t)r;
+#ifdef REDUCED_PRECISION
+    if (this->has_reference() && horizon <= this->horizon_num) this->reference_resource_uses[this->get_delta_index(intervention, start_horizon)] += r;
+#endif
 }
 
-uint_t Instance::get_r_index(uint_t intervention, uint_t start_horizon, uint_t resource, uint_t horizon) {
-    return TO_INDEX(intervention) * this->t_xrxt + TO_INDEX(start_horizon) * this->rxt + TO_INDEX(resource) * this->horizon_num + TO_INDEX(horizon);
+half_fitness_t Instance::get_r(uint_t intervention, uint_t start_horizon, uint_t resource, uint_t horizon) {
+    const uint_set_t &used = this->get_interventions_resources(intervention);
+    if (!this->in_window(intervention, start_horizon, horizon) || used.find(resource) == used.end()) return 0.0;
+    return this->r[this->get_r_index(intervention, start_horizon, resource, horizon)];
 }
 
-uint_t Instance::get_risk_index(string intervention, uint_t start_horizon, uint_t horizon) {
-    return TO_INDEX(this->get_intervention_id(intervention)) * this->t_xt + TO_INDEX(start_horizon) * this->horizon_num + TO_INDEX(horizon);
+ullint_t Instance::get_r_window(uint_t intervention, uint_t start_horizon) const {
+    return this->r_offsets[this->get_delta_index(intervention, start_horizon)];
 }
 
-uint_t Instance::get_risk_index(uint_t intervention, uint_t start_horizon, uint_t horizon) {
-    return TO_INDEX(intervention) * this->t_xt + TO_INDEX(start_horizon) * this->horizon_num + TO_INDEX(horizon);
+ullint_t Instance::get_r_index(string intervention, uint_t start_horizon, string resource, uint_t horizon) {
+    return this->get_r_index(this->get_intervention_id(intervention), start_horizon, this->get_resource_id(resource), horizon);
+}
+
+ullint_t Instance::get_r_index(uint_t intervention, uint_t start_horizon, uint_t resource, uint_t horizon) {
+    ullint_t delta_idx = this->get_delta_index(intervention, start_horizon);
+    uint_t position = this->resource_positions[(ullint_t)TO_INDEX(intervention) * this->resource_num + TO_INDEX(resource)];
+    return this->r_offsets[delta_idx] + (ullint_t)position * this->delta[delta_idx] + (horizon - start_horizon);
+}
+
+/*
+ * appends block of risk rows for each start time of the intervention to the end of risk
+ * start times after t_max get empty blocks
+ */
+void Instance::allocate_risk_windows(uint_t intervention) {
+    ullint_t delta_idx = this->get_delta_index(intervention, 1);
+    ullint_t size = this->risk.size();
+    for (uint_t start = 1; start <= this->horizon_num; ++start) {
+        this->risk_offsets[delta_idx] = size;
+        if (start <= this->get_t_max(intervention)) {
+            uint_t end = min(start + this->delta[delta_idx], this->horizon_num + 1);
+            size += this->scenario_offsets[TO_INDEX(end)] - this->scenario_offsets[TO_INDEX(start)];
+        }
+        delta_idx++;
+    }
+    this->risk.resize(size, 0.0);
+}
+
+ullint_t Instance::get_risk_index(string intervention, uint_t start_horizon, uint_t horizon) {
+    return this->get_risk_index(this->get_intervention_id(intervention), start_horizon, horizon);
+}
+
+ullint_t Instance::get_risk_index(uint_t intervention, uint_t start_horizon, uint_t horizon) {
+    return this->risk_offsets[this->get_delta_index(intervention, start_horizon)] + this->scenario_offsets[TO_INDEX(horizon)] - this->scenario_offsets[TO_INDEX(start_horizon)];
+}
+
+/* reference objective of the row is evaluated as the solution does for intervention scheduled alone, without rounding of the values */
+void Instance::set_risk_row(uint_t intervention, uint_t start_horizon, uint_t horizon, const fitness_t *values) {
+    if (!this->in_window(intervention, start_horizon, horizon)) return;
+    uint_t scenarios = this->get_scenarios(horizon);
+    ullint_t risk_idx = this->get_risk_index(intervention, start_horizon, horizon);
+    for (uint_t s = 0; s < scenarios; ++s) this->risk[risk_idx + s] = (half_fitness_t)values[s];
+#ifdef REDUCED_PRECISION
+    if (!this->has_reference() || horizon > this->horizon_num) return;
+    static thread_local vector<fitness_t> sorted;
+    fitness_t mean = 0.0;
+    for (uint_t s = 0; s < scenarios; ++s) mean += values[s] / scenarios;
+    sorted.assign(values, values + scenarios);
+    uint_t quantile_idx = this->get_quantile_index(horizon);
+    fitness_t excess = 0.0;
+    if (quantile_idx > 0) {
+        nth_element(sorted.begin(), sorted.begin() + quantile_idx - 1, sorted.end());
+        excess = max(sorted[quantile_idx - 1] - mean, 0.0);
+    }
+    this->reference_objectives[this->get_delta_index(intervention, start_horizon)] +=
+        (this->alpha * mean + (1 - this->alpha) * excess) / this->horizon_num;
+#endif
+}
+
+#ifdef REDUCED_PRECISION
+bool Instance::has_reference() const {
+    return !this->reference_objectives.empty();
+}
+
+fitness_t Instance::get_reference_objective(uint_t intervention, uint_t start_horizon) const {
+    return this->reference_objectives[this->get_delta_index(intervention, start_horizon)];
+}
+
+fitness_t Instance::get_reference_resource_use(uint_t intervention, uint_t start_horizon) const {
+    return this->reference_resource_uses[this->get_delta_index(intervention, start_horizon)];
+}
+
+void Instance::clear_reference() {
+    vector<fitness_t>().swap(this->reference_objectives);
+    vector<fitness_t>().swap(this->reference_resource_uses);
+}
+#endif
+
+bool Instance::in_window(uint_t intervention, uint_t start_horizon, uint_t horizon) {
+    return start_horizon <= this->get_t_max(intervention) && horizon >= start_horizon &&
+           horizon < start_horizon + this->delta[this->get_delta_index(intervention, start_horizon)];
+}
+
+/*
+ * workload (risk) of horizon t is compared between each start time and the first start time whose window covers t,
+ * intervention is shift invariant if they never differ
+ */
+void Instance::detect_shift_invariance(uint_t intervention) {
+    uint_t resources = this->get_interventions_resources(intervention).size();
+    uint_vector_t first_start(this->horizon_num + 1, 0);
+    bool workload = true;
+    bool risk = true;
+    uint_t first;
+    uint_t duration;
+    uint_t first_duration;
+    uint_t scenarios;
+    const half_fitness_t *window;
+    const half_fitness_t *first_window;
+    const half_fitness_t *row;
+    const half_fitness_t *first_row;
+    for (uint_t start = 1; start <= this->get_t_max(intervention) && (workload || risk); ++start) {
+        duration = this->delta[this->get_delta_index(intervention, start)];
+        window = this->r.data() + this->get_r_window(intervention, start);
+        for (uint_t t = start; t < start + duration && t <= this->horizon_num; ++t) {
+            first = first_start[t];
+            if (first == 0) {
+                first_start[t] = start;
+                continue;
+            }
+            first_duration = this->delta[this->get_delta_index(intervention, first)];
+            first_window = this->r.data() + this->get_r_window(intervention, first);
+            for (uint_t position = 0; position < resources && workload; ++position) {
+                workload = window[position * duration + t - start] == first_window[position * first_duration + t - first];
+            }
+            scenarios = this->get_scenarios(t);
+            row = this->risk.data() + this->get_risk_index(intervention, start, t);
+            first_row = this->risk.data() + this->get_risk_index(intervention, first, t);
+            risk = risk && equal(row, row + scenarios, first_row);
+        }
+    }
+    if (intervention >= this->shift_invariant_workloads.size()) {
+        this->shift_invariant_workloads.resize(intervention + 1, false);
+        this->shift_invariant_risks.resize(intervention + 1, false);
+    }
+    this->shift_invariant_workloads[intervention] = workload;
+    this->shift_invariant_risks[intervention] = risk;
+}
+
+/* rows are summed scenario by scenario in the same order as from scratch evaluation of the objective does */
+void Instance::compute_mean_risks() {
+    ullint_t delta_idx = 0;
+    ullint_t size = 0;
+    this->mean_risk_offsets.assign(this->ixt_, 0);
+    this->mean_risks.assign(this->ixt, 0.0);
+    for (uint_t intervention : this->interventions) {
+        for (uint_t start = 1; start <= this->horizon_num; ++start, ++delta_idx) {
+            this->mean_risk_offsets[delta_idx] = size;
+            if (start <= this->get_t_max(intervention)) size += min(this->delta[delta_idx], this->horizon_num + 1 - start);
+        }
+    }
+    this->period_mean_risks.assign(size, 0.0);
+    #pragma omp parallel for schedule(dynamic)
+    for (uint_t idx = 0; idx < this->interventions.size(); ++idx) {
+        uint_t intervention = this->interventions[idx];
+        for (uint_t start = 1; start <= this->get_t_max(intervention); ++start) {
+            ullint_t delta_idx = this->get_delta_index(intervention, start);
+            uint_t end = min(start + this->delta[delta_idx], this->horizon_num + 1);
+            const half_fitness_t *row = this->risk.data() + this->get_risk_index(intervention, start, start);
+            fitness_t *means = this->period_mean_risks.data() + this->mean_risk_offsets[delta_idx];
+            fitness_t mean_risk = 0.0;
+            for (uint_t t = start; t < end; ++t) {
+                uint_t scenarios = this->get_scenarios(t);
+                fitness_t mean = 0.0;
+                for (uint_t s = 0; s < scenarios; ++s) mean += (fitness_t)row[s] / scenarios;
+                means[t - start] = mean;
+                mean_risk += mean / this->horizon_num;
+                row += scenarios;
+            }
+            this->mean_risks[delta_idx] = mean_risk;
+        }
+    }
+}
+
+void Instance::compile_descriptors() {
+    this->descriptors.assign(this->ixt, start_descriptor());
+    this->descriptor_resources.clear();
+    for (uint_t intervention : this->interventions) {
+        uint_t resources = this->descriptor_resources.size();
+        const uint_set_t &used = this->get_interventions_resources(intervention);
+        this->descriptor_resources.insert(this->descriptor_resources.end(), used.begin(), used.end());
+        for (uint_t start = 1; start <= this->get_t_max(intervention); ++start) {
+            ullint_t delta_idx = this->get_delta_index(intervention, start);
+            start_descriptor &descriptor = this->descriptors[delta_idx];
+            descriptor.mean_risk = this->mean_risks[delta_idx];
+            descriptor.r_window = this->r_offsets[delta_idx];
+            descriptor.risk_row = this->get_risk_index(intervention, start, start);
+            descriptor.period_mean_risks = this->mean_risk_offsets[delta_idx];
+            descriptor.end = start + this->delta[delta_idx];
+            descriptor.duration = this->delta[delta_idx];
+            descriptor.resources = resources;
+            descriptor.resource_count = used.size();
+        }
+    }
+}
+
+const start_descriptor &Instance::get_descriptor(uint_t intervention, uint_t start_horizon) const {
+    return this->descriptors[this->get_delta_index(intervention, start_horizon)];
+}
+
+const uint_t *Instance::get_descriptor_resources(const start_descriptor &descriptor) const {
+    return this->descriptor_resources.data() + descriptor.resources;
+}
+
+const fitness_t *Instance::get_period_mean_risks(const start_descriptor &descriptor) const {
+    return this->period_mean_risks.data() + descriptor.period_mean_risks;
+}
+
+fitness_t Instance::get_mean_risk(uint_t intervention, uint_t start_horizon) const {
+    return this->mean_risks[this->get_delta_index(intervention, start_horizon)];
+}
+
+const fitness_t *Instance::get_period_mean_risks(uint_t intervention, uint_t start_horizon) const {
+    return this->period_mean_risks.data() + this->mean_risk_offsets[this->get_delta_index(intervention, start_horizon)];
+}
+
+bool Instance::has_shift_invariant_workload(uint_t intervention) const {
+    return this->shift_invariant_workloads[intervention];
+}
+
+bool Instance::has_shift_invariant_risk(uint_t intervention) const {
+    return this->shift_invariant_risks[intervention];
 }
 
 void Instance::add_t_max(string intervention, uint_t t_max) {
@@ -325,6 +631,321 @@ const vector<pair<uint_t, fitness_t>> &Instance::get_avg_deltas() const {
     return this->avg_deltas;
 }
 
+/* header of binary instance image, all sections follow as arrays preceded by their length */
+struct binary_header {
+    char magic[8];
+    uint_t version;
+    uint_t fitness_size;
+    uint_t half_fitness_size;
+    uint_t uint_size;
+    ullint_t source_size;
+    ullint_t source_time;
+    ullint_t file_size;
+};
+
+template<typename T> static void write_array(ofstream &output, const T *data, ullint_t count) {
+    output.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    output.write(reinterpret_cast<const char *>(data), count * sizeof(T));
+}
+
+template<typename T> static void write_array(ofstream &output, const vector<T> &data) {
+    write_array(output, data.data(), data.size());
+}
+
+static void write_string(ofstream &output, const string &value) {
+    write_array(output, value.data(), value.size());
+}
+
+/* reads section at cursor, returns pointer to its items (or nullptr if the image is too short) and moves the cursor behind it */
+template<typename T> static const T *read_array(const char *&cursor, const char *end, ullint_t &count) {
+    if (end - cursor < (long long)sizeof(count)) return nullptr;
+    memcpy(&count, cursor, sizeof(count));
+    cursor += sizeof(count);
+    if ((ullint_t)(end - cursor) / sizeof(T) < count) return nullptr;
+    const T *data = reinterpret_cast<const T *>(cursor);
+    cursor += count * sizeof(T);
+    return data;
+}
+
+template<typename T> static bool read_array(const char *&cursor, const char *end, vector<T> &target) {
+    ullint_t count;
+    const T *data = read_array<T>(cursor, end, count);
+    if (!data) return false;
+    target.resize(count);
+    if (count) memcpy(target.data(), data, count * sizeof(T));
+    return true;
+}
+
+static bool read_string(const char *&cursor, const char *end, string &target) {
+    ullint_t count;
+    const char *data = read_array<char>(cursor, end, count);
+    if (!data) return false;
+    target.assign(data, count);
+    return true;
+}
+
+/* writes image to temporary file first, so concurrent runs never see a partly written one */
+void Instance::save_binary(string path, ullint_t source_size, ullint_t source_time) {
+    string temp_path = path + "." + to_string(getpid());
+    ofstream output(temp_path, ios::binary);
+    if (!output.is_open()) return;
+    binary_header header = {};
+    strncpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+    header.version = BINARY_VERSION;
+    header.fitness_size = sizeof(fitness_t);
+    header.half_fitness_size = sizeof(half_fitness_t);
+    header.uint_size = sizeof(uint_t);
+    header.source_size = source_size;
+    header.source_time = source_time;
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    /* dimensions and evaluation parameters */
+    uint_t dimensions[3] = {this->horizon_num, this->resource_count - 1, this->intervention_count - 1};
+    fitness_t parameters[2] = {this->quantile, this->alpha};
+    write_array(output, dimensions, 3);
+    write_array(output, parameters, 2);
+    write_array(output, &this->computation_time, 1);
+    write_array(output, this->scenarios);
+    /* names in order of ids */
+    for (uint_t resource : this->resources) write_string(output, this->id_to_resource[resource]);
+    for (uint_t intervention : this->interventions) write_string(output, this->id_to_intervention[intervention]);
+    write_array(output, this->u, this->rxt);
+    write_array(output, this->l, this->rxt);
+    write_array(output, this->delta, this->ixt);
+    write_array(output, this->t_max);
+    for (const uint_set_t &used : this->resources_used_by_intervention) {
+        uint_vector_t resources(used.begin(), used.end());
+        write_array(output, resources);
+    }
+    write_array(output, this->r_offsets);
+    write_array(output, this->resource_positions);
+    write_array(output, this->risk_offsets);
+    write_array(output, this->r);
+    write_array(output, this->risk);
+    vector<char> invariant_workloads(this->shift_invariant_workloads.begin(), this->shift_invariant_workloads.end());
+    vector<char> invariant_risks(this->shift_invariant_risks.begin(), this->shift_invariant_risks.end());
+    write_array(output, invariant_workloads);
+    write_array(output, invariant_risks);
+    /* season table and exclusions in the order they were added */
+    ullint_t season_count = this->seasons.size();
+    write_array(output, &season_count, 1);
+    for (const uint_vector_t &season : this->seasons) write_array(output, season);
+    uint_vector_t exclusions;
+    for (const uint_pair_t &exclusion : this->exclusions) {
+        exclusions.push_back(exclusion.first);
+        exclusions.push_back(exclusion.second);
+        exclusions.push_back(this->exclusion_seasons.at({exclusion.first, exclusion.second}));
+    }
+    write_array(output, exclusions);
+    header.file_size = output.tellp();
+    output.seekp(0);
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output.close();
+    if (output.fail() || rename(temp_path.c_str(), path.c_str()) != 0) remove(temp_path.c_str());
+}
+
+/* maps image to memory, all sections are checked before the instance is filled */
+bool Instance::load_binary(string path, ullint_t source_size, ullint_t source_time) {
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) return false;
+    struct stat info;
+    if (fstat(file, &info) != 0 || (ullint_t)info.st_size < sizeof(binary_header)) {
+        close(file);
+        return false;
+    }
+    void *image = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (image == MAP_FAILED) return false;
+    const char *begin = static_cast<const char *>(image);
+    const char *end = begin + info.st_size;
+    binary_header header;
+    memcpy(&header, begin, sizeof(header));
+    bool valid = !strncmp(header.magic, BINARY_MAGIC, sizeof(header.magic)) && header.version == BINARY_VERSION &&
+                 header.fitness_size == sizeof(fitness_t) && header.half_fitness_size == sizeof(half_fitness_t) &&
+                 header.uint_size == sizeof(uint_t) && header.source_size == source_size &&
+                 header.source_time == source_time && header.file_size == (ullint_t)info.st_size;
+    const char *cursor = begin + sizeof(header);
+    uint_vector_t dimensions;
+    vector<fitness_t> parameters;
+    uint_vector_t computation_time;
+    uint_vector_t scenarios;
+    vector<string> resource_names;
+    vector<string> intervention_names;
+    vector<fitness_t> u;
+    vector<fitness_t> l;
+    uint_vector_t delta;
+    uint_vector_t t_max;
+    uint_vector_2d_t used_resources;
+    ullint_vector_t r_offsets;
+    uint_vector_t resource_positions;
+    ullint_vector_t risk_offsets;
+    half_fitness_vector_t r;
+    half_fitness_vector_t risk;
+    vector<char> invariant_workloads;
+    vector<char> invariant_risks;
+    vector<ullint_t> season_count;
+    uint_vector_2d_t seasons;
+    uint_vector_t exclusions;
+    valid = valid && read_array(cursor, end, dimensions) && dimensions.size() == 3 && read_array(cursor, end, parameters) &&
+            read_array(cursor, end, computation_time) && read_array(cursor, end, scenarios);
+    if (valid) {
+        resource_names.resize(dimensions[1]);
+        intervention_names.resize(dimensions[2]);
+        used_resources.resize(dimensions[2]);
+    }
+    for (string &name : resource_names) valid = valid && read_string(cursor, end, name);
+    for (string &name : intervention_names) valid = valid && read_string(cursor, end, name);
+    valid = valid && read_array(cursor, end, u) && read_array(cursor, end, l) && read_array(cursor, end, delta) && read_array(cursor, end, t_max);
+    for (uint_vector_t &used : used_resources) valid = valid && read_array(cursor, end, used);
+    valid = valid && read_array(cursor, end, r_offsets) && read_array(cursor, end, resource_positions) && read_array(cursor, end, risk_offsets) &&
+            read_array(cursor, end, r) && read_array(cursor, end, risk) &&
+            read_array(cursor, end, invariant_workloads) && read_array(cursor, end, invariant_risks) &&
+            read_array(cursor, end, season_count) && season_count.size() == 1;
+    if (valid) seasons.resize(season_count[0]);
+    for (uint_vector_t &season : seasons) valid = valid && read_array(cursor, end, season);
+    valid = valid && read_array(cursor, end, exclusions) && cursor == end;
+    valid = valid && parameters.size() == 2 && computation_time.size() == 1 && scenarios.size() == dimensions[0] &&
+            u.size() == (ullint_t)dimensions[1] * dimensions[0] && l.size() == u.size() &&
+            delta.size() == (ullint_t)dimensions[2] * dimensions[0];
+    munmap(image, info.st_size);
+    if (!valid) return false;
+    /* fill the instance in the same order as the parser does */
+    for (uint_t scenario : scenarios) this->add_scenario(scenario);
+    this->fill_horizons(dimensions[0]);
+    this->set_eval_parameters(parameters[0], parameters[1], computation_time[0]);
+    this->prepare_products(dimensions[2], dimensions[1], dimensions[0]);
+    this->allocate_arrays();
+#ifdef REDUCED_PRECISION
+    this->clear_reference();
+#endif
+    for (const string &name : resource_names) this->add_resource(name);
+    copy(u.begin(), u.end(), this->u);
+    copy(l.begin(), l.end(), this->l);
+    copy(delta.begin(), delta.end(), this->delta);
+    for (const string &name : intervention_names) this->add_intervention(name);
+    this->t_max = std::move(t_max);
+    for (uint_t intervention = 1; intervention <= dimensions[2]; ++intervention) {
+        for (uint_t resource : used_resources[TO_INDEX(intervention)]) this->add_intervention_resource(intervention, resource);
+    }
+    this->r_offsets = std::move(r_offsets);
+    this->resource_positions = std::move(resource_positions);
+    this->risk_offsets = std::move(risk_offsets);
+    this->r = std::move(r);
+    this->risk = std::move(risk);
+    this->shift_invariant_workloads.assign(invariant_workloads.begin(), invariant_workloads.end());
+    this->shift_invariant_risks.assign(invariant_risks.begin(), invariant_risks.end());
+    this->seasons = std::move(seasons);
+    for (uint_t idx = 0; idx + 2 < exclusions.size(); idx += 3) {
+        this->add_exclusion(exclusions[idx], exclusions[idx + 1], exclusions[idx + 2]);
+    }
+    this->compile_exclusions();
+    return true;
+}
+
+/* FNV-1a over 8-byte words, tail bytes are hashed one by one */
+static ullint_t hash_bytes(ullint_t hash, const void *data, ullint_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    ullint_t word;
+    hash = (hash ^ size) * 0x100000001b3ULL;
+    for (; size >= sizeof(word); size -= sizeof(word), bytes += sizeof(word)) {
+        memcpy(&word, bytes, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+    for (; size > 0; --size) hash = (hash ^ (unsigned char)*bytes++) * 0x100000001b3ULL;
+    return hash;
+}
+
+template<typename T> static ullint_t hash_array(ullint_t hash, const vector<T> &data) {
+    return hash_bytes(hash, data.data(), data.size() * sizeof(T));
+}
+
+ullint_t Instance::content_hash() {
+    ullint_t hash = 0xcbf29ce484222325ULL;
+    uint_t dimensions[3] = {this->horizon_num, this->resource_count - 1, this->intervention_count - 1};
+    fitness_t parameters[2] = {this->quantile, this->alpha};
+    hash = hash_bytes(hash, dimensions, sizeof(dimensions));
+    hash = hash_bytes(hash, parameters, sizeof(parameters));
+    hash = hash_array(hash, this->scenarios);
+    hash = hash_bytes(hash, this->u, this->rxt * sizeof(fitness_t));
+    hash = hash_bytes(hash, this->l, this->rxt * sizeof(fitness_t));
+    hash = hash_bytes(hash, this->delta, this->ixt * sizeof(uint_t));
+    hash = hash_array(hash, this->t_max);
+    hash = hash_array(hash, this->r_offsets);
+    hash = hash_array(hash, this->resource_positions);
+    hash = hash_array(hash, this->risk_offsets);
+    hash = hash_array(hash, this->r);
+    hash = hash_array(hash, this->risk);
+    return hash;
+}
+
+struct avg_header {
+    char magic[8];
+    uint_t version;
+    uint_t fitness_size;
+    uint_t uint_size;
+    ullint_t hash;
+    ullint_t file_size;
+};
+
+/* each table is stored sorted as it is held, ids and values in separate sections */
+void Instance::save_avg_properties(string path, ullint_t hash) {
+    string temp_path = path + "." + to_string(getpid());
+    ofstream output(temp_path, ios::binary);
+    if (!output.is_open()) return;
+    avg_header header = {};
+    strncpy(header.magic, AVG_MAGIC, sizeof(header.magic));
+    header.version = AVG_VERSION;
+    header.fitness_size = sizeof(fitness_t);
+    header.uint_size = sizeof(uint_t);
+    header.hash = hash;
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (const vector<pair<uint_t, fitness_t>> *table : {&this->avg_deltas, &this->avg_costs, &this->avg_rds}) {
+        uint_vector_t ids;
+        vector<fitness_t> values;
+        for (const pair<uint_t, fitness_t> &item : *table) {
+            ids.push_back(item.first);
+            values.push_back(item.second);
+        }
+        write_array(output, ids);
+        write_array(output, values);
+    }
+    header.file_size = output.tellp();
+    output.seekp(0);
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output.close();
+    if (output.fail() || rename(temp_path.c_str(), path.c_str()) != 0) remove(temp_path.c_str());
+}
+
+bool Instance::load_avg_properties(string path, ullint_t hash) {
+    ifstream input(path, ios::binary);
+    if (!input.is_open()) return false;
+    vector<char> image((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+    if (image.size() < sizeof(avg_header)) return false;
+    const char *cursor = image.data();
+    const char *end = cursor + image.size();
+    avg_header header;
+    memcpy(&header, cursor, sizeof(header));
+    cursor += sizeof(header);
+    if (strncmp(header.magic, AVG_MAGIC, sizeof(header.magic)) || header.version != AVG_VERSION ||
+        header.fitness_size != sizeof(fitness_t) || header.uint_size != sizeof(uint_t) ||
+        header.hash != hash || header.file_size != image.size()) return false;
+    vector<pair<uint_t, fitness_t>> tables[3];
+    uint_vector_t ids;
+    vector<fitness_t> values;
+    for (vector<pair<uint_t, fitness_t>> &table : tables) {
+        if (!read_array(cursor, end, ids) || !read_array(cursor, end, values) || ids.size() != values.size() ||
+            ids.size() != this->interventions.size()) return false;
+        for (uint_t idx = 0; idx < ids.size(); ++idx) {
+            if (ids[idx] < 1 || ids[idx] >= this->intervention_count) return false;
+            table.emplace_back(ids[idx], values[idx]);
+        }
+    }
+    if (cursor != end) return false;
+    this->set_avg_deltas(std::move(tables[0]));
+    this->set_avg_costs(std::move(tables[1]));
+    this->set_avg_rds(std::move(tables[2]));
+    return true;
+}
+
 /* adds string and its id to maps (both directions) */
 void add_to_translate_maps(string_to_uint_t *id_map, uint_to_string_t *name_map, string name, uint_t id) {
     (*id_map).insert(pair<string, uint_t>(name, id));
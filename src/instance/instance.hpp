@@ -8,11 +8,24 @@
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "hashing.hpp"
 #include "../util.hpp"
 #include "../types.hpp"
-#include "../ranges.hpp"
+
+#define BINARY_MAGIC ("ROADEFI")
+#define BINARY_VERSION 1 /* has to be increased with every change of the binary layout or of the stored arrays */
+#define AVG_MAGIC ("ROADEFA")
+#define AVG_VERSION 1 /* has to be increased with every change of the layout or of the way average properties are computed */
+#define SMALL_SCENARIOS 16 /* horizons with up to this many scenarios get risk kernels specialized for their count, see solution.cpp */
 
 using namespace std;
 using namespace hashing;
@@ -23,23 +36,34 @@ typedef unordered_map<uint_t, uint_t> uint_to_uint_t;
 typedef unordered_map<pair_key, uint_t, pair_hash> pair_to_uint_t;
 typedef vector<half_fitness_t> half_fitness_vector_t;
 typedef vector<uint_t> uint_vector_t;
+typedef vector<ullint_t> ullint_vector_t;
 typedef set<uint_t> uint_set_t;
 typedef pair<uint_t, uint_t> uint_pair_t;
 typedef vector<uint_pair_t> uint_pair_vector_t;
 typedef vector<vector<uint_t>> uint_vector_2d_t;
 typedef vector<uint_set_t> uint_set_vector_t;
 
+/* what estimates need to know about intervention started in a horizon, one cache line per start time */
+struct alignas(64) start_descriptor {
+    fitness_t mean_risk; /* mean risk objective change of scheduling the intervention at the start time */
+    ullint_t r_window; /* index to r of the first workload of the window */
+    ullint_t risk_row; /* index to risk of the first scenario of the start horizon */
+    ullint_t period_mean_risks; /* index to mean risks of horizons of the window */
+    uint_t end; /* first horizon after the window (start time + delta) */
+    uint_t duration; /* delta of the start time */
+    uint_t resources; /* index to descriptor resources of the first resource used by the intervention */
+    uint_t resource_count;
+};
+
 class Instance {
     private:
         /* variables that hold products of different parameters to avoid unnecessary multiplication */
-        uint_t rxt = PROD_RT; // size of array [r][t]
-        uint_t ixt = PROD_IT; // size of array [i][t]
-        uint_t ixt_ = PROD_IT; // size of array [i][t']
-        uint_t ixt_xt = PROD_ITT; // size of array [i][t'][t]
-        uint_t ixt_xr = PROD_ITR; // size of array [i][t'][r]
-        uint_t ixt_xrxt = PROD_ITRT; // size of array [i][t'][r][t]
-        uint_t t_xrxt = PROD_TRT; // size of array [t'][r][t]
-        uint_t t_xt = PROD_TT; // size of array [t'][t]
+        ullint_t rxt = 0; // size of array [r][t]
+        ullint_t ixt = 0; // size of array [i][t]
+        ullint_t ixr = 0; // size of array [i][r]
+        ullint_t ixt_ = 0; // size of array [i][t']
+        ullint_t ixt_xr = 0; // size of array [i][t'][r]
+        uint_t resource_num = 0; // number of resources in the instance
 
         /* resource maps and counter */
         uint_t resource_count = 1;
@@ -55,6 +79,33 @@ class Instance {
 
         /* holds resources that are used by an intervention */
         uint_set_vector_t resources_used_by_intervention;
+        uint_vector_t resource_positions; /* [i][r] -> order of resource r among resources used by intervention i */
+
+        /* offsets into workload buffer r, indexed as [i][t'] */
+        ullint_vector_t r_offsets;
+        /* offsets into risk buffer, indexed as [i][t'] */
+        ullint_vector_t risk_offsets;
+        /* number of scenarios in all horizons before given horizon */
+        ullint_vector_t scenario_offsets;
+        /* index of the quantile among cumulative risks of each horizon (indexed from 1 as in solution) */
+        uint_vector_t quantile_indices;
+        /* risk kernel of each horizon, its scenario count if it is at most SMALL_SCENARIOS, 0 otherwise */
+        uint_vector_t scenario_kernels;
+        /* offsets into period_mean_risks, indexed as [i][t'] */
+        ullint_vector_t mean_risk_offsets;
+        /* mean risk over scenarios of each risk row, rows of [i][t'] are stored one after another as in risk */
+        vector<fitness_t> period_mean_risks;
+        /* change of mean risk objective caused by scheduling intervention at start time, indexed as [i][t'] */
+        vector<fitness_t> mean_risks;
+        /* descriptors of start times indexed as [i][t'], only valid for start times up to t_max */
+        vector<start_descriptor> descriptors;
+        /* ascending ids of resources used by each intervention stored one after another */
+        uint_vector_t descriptor_resources;
+#ifdef REDUCED_PRECISION
+        /* objective and resource use of scheduling intervention alone computed from values before rounding, indexed as [i][t'] */
+        vector<fitness_t> reference_objectives;
+        vector<fitness_t> reference_resource_uses;
+#endif
 
         /* horizons and scenarios fields */
         uint_t horizon_num;
@@ -68,9 +119,18 @@ class Instance {
         uint_vector_2d_t time_exclusions; /* map time horizon to vector of indexes into exclusions table */
         uint_vector_2d_t exclusions_by_interventions; /* map intervention to vector of interventions in exclusion */
         uint_set_t interventions_with_exclusions; /* set of interventions, that are in some exclusion */
+        /* exclusions compiled for hot paths, partners of intervention i are items exclusion_offsets[i] <= k < exclusion_offsets[i + 1] */
+        uint_vector_t exclusion_offsets;
+        uint_vector_t exclusion_partners; /* intervention in exclusion with the owner of the item */
+        uint_vector_t exclusion_partner_seasons; /* row of season table of the exclusion */
+        uint_vector_t season_prefixes; /* [season][t] number of horizons of season up to horizon t, 0 <= t <= horizon_num */
 
         uint_vector_t t_max; /* latest horizon to start corresponding intervention */
 
+        /* interventions whose workloads (risks) in a horizon are the same for all start times covering the horizon */
+        vector<bool> shift_invariant_workloads;
+        vector<bool> shift_invariant_risks;
+
         fitness_t quantile;
         fitness_t alpha;
         uint_t computation_time;
@@ -94,9 +154,17 @@ class Instance {
 
         uint_t *delta;
 
-        half_fitness_t *r;
+        /*
+         * workload windows stored one after another, for each [i][t'] there is a block of delta(i, t') values
+         * for each resource used by the intervention (in ascending order of resource ids), workloads out of the window are zero
+         */
+        half_fitness_vector_t r;
 
-        half_fitness_vector_t *risk;
+        /*
+         * risk scenarios stored one after another, for each [i][t'] there is a block of rows for horizons t' <= t < t' + delta(i, t'),
+         * row of horizon t holds values of all scenarios in t
+         */
+        half_fitness_vector_t risk;
 
         uint_t add_resource(string name); /* adds resource with passed name to maps and vector */
         /* translate resource to id and vice versa */
@@ -122,6 +190,9 @@ class Instance {
         uint_vector_t get_scenarios_vector(uint_t horizon); /* returns vector that contains individual scnarios in given time in ascending order */
         uint_t get_scenarios_count(); /* returns number of scenarios */
         uint_t get_max_scenarios();
+        ullint_t get_scenario_offset(uint_t horizon) const; /* returns number of scenarios in all horizons before given horizon */
+        uint_t get_quantile_index(uint_t horizon) const; /* returns ceil(scenarios * quantile) of given horizon */
+        uint_t get_scenario_kernel(uint_t horizon) const; /* returns index of risk kernel for given horizon */
 
         void set_eval_parameters(fitness_t quantile, fitness_t alpha, uint_t comp_time); /* loads parameters used for evaluation */
 
@@ -134,8 +205,8 @@ class Instance {
         void add_exclusion(string intervention1, string intervention2, uint_t season_id);
         void add_exclusion(uint_t intervention1, uint_t intervention2, uint_t season_id);
         /* gets vector that contains times where two passed interventions cannot be conducted at once */
-        uint_vector_t get_exclusion_season(uint_t intervetion1, uint_t intervention2);
-        uint_vector_t get_exclusion_season(string intervention1, string intervention2);
+        const uint_vector_t &get_exclusion_season(uint_t intervetion1, uint_t intervention2) const;
+        const uint_vector_t &get_exclusion_season(string intervention1, string intervention2);
         /* get vector of pairs of interventions that are excluded in passed time_horizon */
         const uint_pair_vector_t get_exclusions(uint_t time_horizon) const;
         const uint_pair_vector_t get_exclusion_pairs() const;
@@ -143,20 +214,72 @@ class Instance {
         const uint_vector_t& get_excluded(uint_t intervention) const;
         /* get a set of interventions, that are in some exclusion */
         const uint_set_t& get_interventions_with_exclusions() const;
+        /* builds adjacency of exclusions and prefix sums of seasons, has to be called after all exclusions are added */
+        void compile_exclusions();
+        /* range of items of compiled exclusions of the intervention */
+        uint_t get_exclusion_begin(uint_t intervention) const;
+        uint_t get_exclusion_end(uint_t intervention) const;
+        uint_t get_exclusion_partner(uint_t item) const;
+        uint_t get_exclusion_season_id(uint_t item) const;
+        const uint_vector_t &get_season(uint_t season) const;
+        /* number of horizons of season covered by both windows start <= t < end */
+        uint_t count_season_overlap(uint_t season, uint_t start1, uint_t end1, uint_t start2, uint_t end2) const;
+
+        ullint_t get_ul_index(string resource, uint_t horizon);
+        ullint_t get_ul_index(uint_t resource, uint_t horizon) const;
+
+        ullint_t get_delta_index(string intervention, uint_t horizon);
+        ullint_t get_delta_index(uint_t intervention, uint_t horizon) const;
+
+        /* marks resource as used by intervention, has to be called for all resources before allocating workload windows */
+        void add_intervention_resource(uint_t intervention, uint_t resource);
+        /* reserves workload windows of all start times of the intervention (deltas and t_max have to be known) */
+        void allocate_r_windows(uint_t intervention);
+        /* stores workload, values out of the window of given start time are ignored */
+        void add_r(uint_t intervention, uint_t start_horizon, uint_t resource, uint_t horizon, fitness_t r);
+        /* gets workload of intervention in given time (zero when out of window or resource not used) */
+        half_fitness_t get_r(uint_t intervention, uint_t start_horizon, uint_t resource, uint_t horizon);
+
+        /* index to r of the first workload of intervention started in start_horizon (windows of used resources follow) */
+        ullint_t get_r_window(uint_t intervention, uint_t start_horizon) const;
+        /* index to r, only valid for resources used by the intervention and horizons inside the window */
+        ullint_t get_r_index(string intervention, uint_t start_horizon, string resource, uint_t horizon);
+        ullint_t get_r_index(uint_t intervention, uint_t start_horizon, uint_t resource, uint_t horizon);
+
+        /* reserves risk rows of all start times of the intervention (deltas and t_max have to be known) */
+        void allocate_risk_windows(uint_t intervention);
+        /* index to risk of the first scenario in horizon, only valid for horizons inside the window */
+        ullint_t get_risk_index(uint_t intervention, uint_t start_horizon, uint_t horizon);
+        ullint_t get_risk_index(string intervention, uint_t start_horizon, uint_t horizon);
+        /* stores risks of all scenarios in horizon, rows out of the window of given start time are ignored */
+        void set_risk_row(uint_t intervention, uint_t start_horizon, uint_t horizon, const fitness_t *values);
+#ifdef REDUCED_PRECISION
+        /* reference values are only collected while json is processed, see Parser::validate_precision */
+        bool has_reference() const;
+        fitness_t get_reference_objective(uint_t intervention, uint_t start_horizon) const;
+        fitness_t get_reference_resource_use(uint_t intervention, uint_t start_horizon) const;
+        void clear_reference();
+#endif
 
-        uint_t get_ul_index(string resource, uint_t horizon);
-        uint_t get_ul_index(uint_t resource, uint_t horizon);
-
-        uint_t get_delta_index(string intervention, uint_t horizon);
-        uint_t get_delta_index(uint_t intervention, uint_t horizon);
-
-        void add_r(uint_t intervention, uint_t resource, uint_t index, half_fitness_t r);
-
-        uint_t get_r_index(string intervention, uint_t start_horizon, string resource, uint_t horizon);
-        uint_t get_r_index(uint_t intervention, uint_t start_horizon, uint_t resource, uint_t horizon);
-
-        uint_t get_risk_index(uint_t intervention, uint_t start_horizon, uint_t horizon);
-        uint_t get_risk_index(string intervention, uint_t start_horizon, uint_t horizon);
+        /* checks if intervention started in start_horizon is performed in horizon */
+        bool in_window(uint_t intervention, uint_t start_horizon, uint_t horizon);
+
+        /* compares windows of all start times of the intervention, has to be called after its workloads and risks are stored */
+        void detect_shift_invariance(uint_t intervention);
+        /* fills mean risk tables, has to be called after all risks are stored */
+        void compute_mean_risks();
+        /* mean risk objective change of scheduling the intervention, it does not depend on the rest of the solution */
+        fitness_t get_mean_risk(uint_t intervention, uint_t start_horizon) const;
+        /* mean risks over scenarios of horizons in window indexed from 0 for start horizon */
+        const fitness_t *get_period_mean_risks(uint_t intervention, uint_t start_horizon) const;
+        /* fills descriptors of start times, has to be called after mean risks are computed */
+        void compile_descriptors();
+        const start_descriptor &get_descriptor(uint_t intervention, uint_t start_horizon) const;
+        /* ids of resources used by the intervention as listed by its descriptors */
+        const uint_t *get_descriptor_resources(const start_descriptor &descriptor) const;
+        const fitness_t *get_period_mean_risks(const start_descriptor &descriptor) const;
+        bool has_shift_invariant_workload(uint_t intervention) const;
+        bool has_shift_invariant_risk(uint_t intervention) const;
 
         /* add latest time horizon to start passed intervention */
         void add_t_max(string intervention, uint_t t_max);
@@ -176,6 +299,18 @@ class Instance {
         const vector<pair<uint_t, fitness_t>>& get_avg_deltas() const;
         const vector<pair<uint_t, fitness_t>>& get_avg_costs() const;
         const vector<pair<uint_t, fitness_t>>& get_avg_rds() const;
+
+        /*
+         * binary image of everything parsed from json (mean risks and average properties are not included), source_size and source_time
+         * identify the json file it was created from, load fails without touching the instance if the image does not match
+         */
+        void save_binary(string path, ullint_t source_size, ullint_t source_time);
+        bool load_binary(string path, ullint_t source_size, ullint_t source_time);
+        /* hash of all data average properties are computed from (scenarios, evaluation parameters, bounds, windows, workloads and risks) */
+        ullint_t content_hash();
+        /* average properties stored for instance with the content hash, load fails without touching the instance if the hash does not match */
+        void save_avg_properties(string path, ullint_t hash);
+        bool load_avg_properties(string path, ullint_t hash);
     ;
 };
 
@@ -40,15 +40,15 @@ bool one_shift(Solution &solution) {
 
 
     if (LS_FIRST_IMPROVE) {
+        vector<Objective> estimates;
         for (int id = 0; id < interventions.size(); id++) {
             auto i = interventions[id];
             if (!improved) {
-                Solution cur_sol = solution;
-                cur_sol.unschedule(i);
-                if (best_score - cur_sol.extended_objective > ACCEPT_TOLERANCE) { // bound by best_score
+                if (best_score - solution.estimate_unschedule(i).extended_objective > ACCEPT_TOLERANCE) { // bound by best_score
+                    solution.estimate_move_times(i, estimates);
                     for (uint_t t = 1; t <= solution.instance->get_t_max(i); ++t) {
                         if (improved) break;
-                        auto cur_score = cur_sol.estimate_schedule(i, t).extended_objective;
+                        auto cur_score = estimates[t].extended_objective;
                         if (best_score - cur_score > ACCEPT_TOLERANCE) {
                             improved = true;
                             best_score = cur_score;
@@ -71,12 +71,13 @@ bool one_shift(Solution &solution) {
             vector<fitness_t> temp;
             temp.reserve(times);
             temp.push_back(0.0);
-            Solution cur_sol = solution;
-            cur_sol.unschedule(i);
-            fitness_t val = cur_sol.extended_objective;
+            // moves are estimated against the shared solution, no copy is needed
+            vector<Objective> estimates;
+            fitness_t val = solution.estimate_unschedule(i).extended_objective;
             if (best_score - val > 10 * ACCEPT_TOLERANCE) {
+                solution.estimate_move_times(i, estimates);
                 for (uint_t t = 1; t <= times; ++t) {
-                    fitness_t cur_score = cur_sol.estimate_schedule(i, t).extended_objective;
+                    fitness_t cur_score = estimates[t].extended_objective;
                     temp.push_back(cur_score);
                     fitness_t x = best_score.load();
                     while (x > cur_score && !best_score.compare_exchange_strong(x, cur_score));
@@ -118,18 +119,21 @@ estimate two_shift_estimate(Solution &solution, uint_t i1, uint_t i2) {
     estimate best = { .score = solution.extended_objective, .t1 = 0, .t2 = 0 };
     bool improved = false;
 
-    auto cur_sol = solution;
-    cur_sol.unschedule(i1);
-    cur_sol.unschedule(i2);
+    // moves are estimated against the solution itself, it is neither copied nor modified
+    vector<Objective> estimates;
+    uint_t interventions[2] = {i1, i2};
+    uint_t old_starts[2] = {solution.get_start_time(i1), solution.get_start_time(i2)};
+    uint_t new_starts[2] = {0, 0};
 
-    if (best.score - cur_sol.extended_objective > ACCEPT_TOLERANCE) { // bound cur_sol without i1, i2
+    if (best.score - solution.estimate_moves(interventions, old_starts, new_starts, 2).extended_objective > ACCEPT_TOLERANCE) { // bound solution without i1, i2
         for (uint_t t1 = 1; t1 <= solution.instance->get_t_max(i1); ++t1) {
             if (LS_FIRST_IMPROVE && improved) break;
-            cur_sol.schedule(i1, t1);
-            if (best.score - cur_sol.extended_objective > ACCEPT_TOLERANCE) { // bound cur_sol without i2
+            new_starts[0] = t1;
+            if (best.score - solution.estimate_moves(interventions, old_starts, new_starts, 2).extended_objective > ACCEPT_TOLERANCE) { // bound solution without i2
+                solution.estimate_two_move_times(i1, t1, i2, estimates);
                 for (uint_t t2 = 1; t2 <= solution.instance->get_t_max(i2); ++t2) {
                     if (LS_FIRST_IMPROVE && improved) break;
-                    auto cur_score = cur_sol.estimate_schedule(i2, t2).extended_objective;
+                    auto cur_score = estimates[t2].extended_objective;
                     if (best.score - cur_score > ACCEPT_TOLERANCE) {
                         improved = true;
                         best.score = cur_score;
@@ -138,7 +142,6 @@ estimate two_shift_estimate(Solution &solution, uint_t i1, uint_t i2) {
                     }
                 }
             }
-            cur_sol.unschedule(i1);
         }
     }
 
@@ -25,13 +25,20 @@ int main(int argc, char *argv[]) {
 
     parse_global_params(argc, argv);
 
-    /* parse file placed as first argument*/
+    /* parse file placed as first argument, binary image of the file is used instead when there is one */
     Parser *parser = new Parser(INPUT_PATH);
-    parser->load();
-
-    /* interpret data from parsed data */
     Instance instance;
-    parser->process(&instance);
+    if (!INSTANCE_CACHE || !parser->load_binary(&instance)) {
+        if (STREAM_PARSER) {
+            parser->stream(&instance);
+        } else {
+            parser->load();
+
+            /* interpret data from parsed data */
+            parser->process(&instance);
+        }
+        if (INSTANCE_CACHE) parser->save_binary(&instance);
+    }
 
     determine_dependent_params(&instance);
 
@@ -44,8 +51,13 @@ int main(int argc, char *argv[]) {
 
 //    omp_set_num_threads(4);
 
-    ALNS search(&instance, SEED);
-    auto solution = search.greedy_search();
+    Solution solution;
+    if (THREADS > 1) {
+        solution = parallel_greedy_search(&instance, SEED, THREADS);
+    } else {
+        ALNS search(&instance, SEED);
+        solution = search.greedy_search();
+    }
     solution.round_up(2);
 //    solution.print_state();
     solution.save(OUTPUT_PATH);
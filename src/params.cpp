@@ -7,6 +7,7 @@ std::string OUTPUT_PATH{"solution.txt"};
 uint_t TIME_LIMIT{15 * 60 * 1000 - TIME_RESERVE};
 bool RETURN_ID{false};
 int SEED{1};
+uint_t THREADS{1};
 std::chrono::steady_clock::time_point BEGIN{std::chrono::steady_clock::now()};
 uint_t sol_progress_cnt{0};
 
@@ -213,6 +214,8 @@ const char *insertions_labels[INSERT_COUNT]{
         [N3_MOST_USED_INSERT] = "N3_MOST_USED_INSERT",
         [N3_LEAST_USED_INSERT] = "N3_LEAST_USED_INSERT",
 
+        [REGRET2_INSERT] = "REGRET2_INSERT",
+        [REGRET3_INSERT] = "REGRET3_INSERT",
 };
 
 const char *removals_labels[REMOVE_COUNT]{
@@ -309,6 +312,7 @@ void dump_config() {
     // other
     cout << "\t" << SEED_LABEL << " : " << SEED << endl;
     cout << "\t" << TIME_LIMIT_LABEL << " : " << TIME_LIMIT << endl;
+    cout << "\t" << THREADS_LABEL << " : " << THREADS << endl;
     cout << "}" << endl;
 }
 
@@ -358,6 +362,7 @@ void parse_global_params(int argc, char *argv[]) {
         else if (!strcmp(label, OUTPUT_PATH_LABEL)) OUTPUT_PATH = val;
         else if (!strcmp(label, TIME_LIMIT_LABEL)) TIME_LIMIT = 1000 * util::convert_to_int(val) - TIME_RESERVE;
         else if (!strcmp(label, SEED_LABEL)) SEED = stoi(val);
+        else if (!strcmp(label, THREADS_LABEL)) THREADS = max(util::convert_to_int(val), (uint_t) 1);
         else if (!strcmp(label, SEED_LABEL));
         else if (!strcmp(label, TEAM_ID_LABEL)) {
             if (argc == 2) {
@@ -482,7 +487,7 @@ void ALNS_setup::check_setup() {
 //                                          0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};            // v9.8 setup
 //        this->insertions = vector<uint_t>{1, 1, 0, 1, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0,
 //                                          0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};  // v11.2 setup
-        this->insertions = vector<uint_t>{0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0};  // v12.3 setup
+        this->insertions = vector<uint_t>{0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0};  // v12.3 setup
     }
 
     if (this->default_removals) {
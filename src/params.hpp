@@ -50,11 +50,18 @@
 #define OUTPUT_PATH_LABEL ("-o")
 #define TIME_LIMIT_LABEL ("-t")
 #define SEED_LABEL ("-s")
+#define THREADS_LABEL ("-threads")
 #define TEAM_ID_LABEL ("-name")
 #define TEAM_ID 49
 #define CONSTRUCTION_LABEL ("CONSTRUCTION")
 #define NUMERIC_TOLERANCE 0.00001
 #define TIME_RESERVE 600
+// Json file is read in two streaming passes instead of holding whole document in memory
+#define STREAM_PARSER (true)
+// Binary image of parsed instance stored next to the json file
+#define INSTANCE_CACHE (true)
+#define INSTANCE_CACHE_SUFFIX (".bin")
+#define AVG_CACHE_SUFFIX (".avg") // average properties of interventions, valid while content hash of the instance matches
 // Continuous solution saving
 #define SAVE_SOL_PROGRESS (false)
 #define SOL_PROGRESS_DIR ("./solutions/sol_progress/")
@@ -67,6 +74,7 @@ extern uint_t TIME_LIMIT; // ALNS loop time limit (in milliseconds)
 extern std::chrono::steady_clock::time_point BEGIN;
 extern bool RETURN_ID;
 extern int SEED;
+extern uint_t THREADS; // number of ALNS workers searching in parallel
 
 // DEPENDENT PARAMETERS - COEFFICIENTS
 extern int ITERS_MAX;
@@ -229,6 +237,7 @@ enum insertion_idx {
     N2_SHORTEST1_INSERT, N2_MOST_EXCLUSIONS_INSERT, N2_LEAST_EXCLUSIONS_INSERT, N2_MOST_USED_INSERT, N2_LEAST_USED_INSERT,
     N3_CHEAPEST_INSERT, N3_MOST_EXPENSIVE_INSERT, N3_LRD1_INSERT, N3_HRD_INSERT, N3_LONGEST1_INSERT,
     N3_SHORTEST1_INSERT, N3_MOST_EXCLUSIONS_INSERT, N3_LEAST_EXCLUSIONS_INSERT, N3_MOST_USED_INSERT, N3_LEAST_USED_INSERT,
+    REGRET2_INSERT, REGRET3_INSERT,
     INSERT_COUNT
 };
 
@@ -13,8 +13,57 @@ void Parser::load() {
     } else util::throw_err("Error while opening file");
 }
 
+bool Parser::source_stamp(ullint_t &size, ullint_t &time) {
+    struct stat info;
+    if (stat(this->path_to_file.c_str(), &info) != 0) return false;
+    size = info.st_size;
+    time = (ullint_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+    return true;
+}
+
+/* binary image skips json parsing, mean risks, descriptors and average properties are computed again as they are not stored in it */
+bool Parser::load_binary(Instance *instance) {
+    ullint_t size;
+    ullint_t time;
+    if (!this->source_stamp(size, time)) return false;
+    if (!instance->load_binary(this->path_to_file + INSTANCE_CACHE_SUFFIX, size, time)) return false;
+    instance->compute_mean_risks();
+    instance->compile_descriptors();
+    this->process_avg_properties(instance);
+    return true;
+}
+
+void Parser::save_binary(Instance *instance) {
+    ullint_t size;
+    ullint_t time;
+    if (this->source_stamp(size, time)) instance->save_binary(this->path_to_file + INSTANCE_CACHE_SUFFIX, size, time);
+}
+
 /* extracts data from json object and translates them to instance object */
 void Parser::process(Instance *instance) {
+    this->process_data(instance);
+    this->process_derived(instance);
+}
+
+void Parser::stream(Instance *instance) {
+    ifstream input;
+    /* first pass: everything except values of workloads and risks is kept in j */
+    SkeletonHandler skeleton(this->j);
+    input.open(this->path_to_file);
+    if (!input.is_open()) util::throw_err("Error while opening file");
+    if (!json::sax_parse(input, &skeleton)) util::throw_err("Error while parsing file");
+    input.close();
+    /* windows are allocated, resources used by interventions are known from the kept workload keys */
+    this->process_data(instance);
+    /* second pass: workloads and risks */
+    StreamHandler handler(instance);
+    input.open(this->path_to_file);
+    if (!input.is_open()) util::throw_err("Error while opening file");
+    if (!json::sax_parse(input, &handler)) util::throw_err("Error while parsing file");
+    this->process_derived(instance);
+}
+
+void Parser::process_data(Instance *instance) {
      /* extract scenarios */
     for (auto& i : j[SCENARIOS]) {
         instance->add_scenario(i);
@@ -31,7 +80,7 @@ void Parser::process(Instance *instance) {
     uint_t map_key;
     instance->prepare_products(j[INTERVENTIONS].size(), j[RESOURCES].size(), j[HORIZONS]);
     instance->allocate_arrays();
-    uint_t idx;
+    ullint_t idx;
     for (auto& i : j[RESOURCES].items()) {
         map_key = instance->add_resource(i.key());
         /* store maximum and mininimum for each resource in time horizons */
@@ -45,8 +94,12 @@ void Parser::process(Instance *instance) {
             instance->l[idx++] = min;
         }
     }
-    /* map interventions */
+    /* map interventions, windows are appended to r and risk so they are allocated in order of ids */
     uint_t t_max;
+    uint_t interventions = j[INTERVENTIONS].size();
+    vector<const json *> workloads(interventions);
+    vector<const json *> risks(interventions);
+    vector<uint_vector_t> workload_resources(interventions); /* ids of resources in order of workload items */
     for (auto& i : j[INTERVENTIONS].items()) {
         /* translate name into unique key */
         map_key = instance->add_intervention(i.key());
@@ -54,37 +107,237 @@ void Parser::process(Instance *instance) {
         t_max = util::convert_to_int(i.value()[T_MAX]);
         instance->add_t_max(map_key, t_max);
         /* store deltas */
-        uint_t horizon = 1;
         idx = instance->get_delta_index(map_key, 1);
         for (uint_t delta : i.value()[DELTA]) {
             instance->delta[idx++] = delta;
         }
+        /* reserve workload windows of used resources for each start time */
+        workloads[TO_INDEX(map_key)] = &i.value()[WORKLOAD];
+        risks[TO_INDEX(map_key)] = &i.value()[RISK];
+        for (auto &resource : i.value()[WORKLOAD].items()) {
+            workload_resources[TO_INDEX(map_key)].push_back(instance->get_resource_id(resource.key()));
+            instance->add_intervention_resource(map_key, workload_resources[TO_INDEX(map_key)].back());
+        }
+        instance->allocate_r_windows(map_key);
+        instance->allocate_risk_windows(map_key);
+    }
+    /* interventions fill disjoint slices of r and risk, json is only read */
+    #pragma omp parallel for schedule(dynamic)
+    for (uint_t intervention = 1; intervention <= interventions; ++intervention) {
         uint_t t_int;
-        uint_t idx;
-        uint_t resource_id;
+        uint_t start_int;
+        uint_t position = 0;
         /* store resources needed for each intervention in timehorizon based on start time */
-        for (auto &resource : i.value()[WORKLOAD].items()) {
-            resource_id = instance->get_resource_id(resource.key());
+        for (auto &resource : workloads[TO_INDEX(intervention)]->items()) {
+            uint_t resource_id = workload_resources[TO_INDEX(intervention)][position++];
             for (auto &time : resource.value().items()) {
                 t_int = util::convert_to_int(time.key());
                 for (auto &start_time : time.value().items()) {
-                    idx = instance->get_r_index(map_key, util::convert_to_int(start_time.key()), resource_id, t_int);
-                    instance->add_r(map_key, resource_id, idx, start_time.value());
+                    instance->add_r(intervention, util::convert_to_int(start_time.key()), resource_id, t_int, start_time.value());
                 }
             }
         }
         /* store risks (cost) of each intervention in time and scenario based on start time */
-        for (auto &time : i.value()[RISK].items()) {
+        vector<fitness_t> row;
+        for (auto &time : risks[TO_INDEX(intervention)]->items()) {
             t_int = util::convert_to_int(time.key());
             for (auto &start_time : time.value().items()) {
-                for (uint_t scenario = 0; scenario < instance->get_scenarios(t_int); ++scenario) {
-                    instance->risk[instance->get_risk_index(map_key, util::convert_to_int(start_time.key()), t_int)].push_back((half_fitness_t)start_time.value()[scenario]);
+                start_int = util::convert_to_int(start_time.key());
+                if (!instance->in_window(intervention, start_int, t_int)) continue;
+                row.resize(instance->get_scenarios(t_int));
+                for (uint_t scenario = 0; scenario < row.size(); ++scenario) {
+                    row[scenario] = start_time.value()[scenario];
                 }
+                instance->set_risk_row(intervention, start_int, t_int, row.data());
             }
         }
     }
+}
+
+void Parser::process_derived(Instance *instance) {
+    for (uint_t intervention : instance->get_interventions()) {
+        instance->detect_shift_invariance(intervention);
+    }
+    instance->compute_mean_risks();
+    instance->compile_descriptors();
     this->process_exclusions(instance);
     this->process_avg_properties(instance);
+#ifdef REDUCED_PRECISION
+    if (instance->has_reference()) this->validate_precision(instance);
+#endif
+}
+
+/* converts key that holds horizon to number without copying it */
+static uint_t key_to_horizon(const string &key) {
+    uint_t num = 0;
+    for (char c : key) {
+        if (c < '0' || c > '9') util::throw_err("convert from string to int failed");
+        num = 10 * num + (c - '0');
+    }
+    return num;
+}
+
+SkeletonHandler::SkeletonHandler(json &j) : dom(j) {}
+
+/* skipped value ends when nesting returns to the depth of its key */
+bool SkeletonHandler::skipped() {
+    if (!this->skipping) return false;
+    if (this->depth == this->skip_depth) this->skipping = false;
+    return true;
+}
+
+bool SkeletonHandler::null() { return this->skipped() || this->dom.null(); }
+
+bool SkeletonHandler::boolean(bool val) { return this->skipped() || this->dom.boolean(val); }
+
+bool SkeletonHandler::number_integer(number_integer_t val) { return this->skipped() || this->dom.number_integer(val); }
+
+bool SkeletonHandler::number_unsigned(number_unsigned_t val) { return this->skipped() || this->dom.number_unsigned(val); }
+
+bool SkeletonHandler::number_float(number_float_t val, const string_t &s) { return this->skipped() || this->dom.number_float(val, s); }
+
+bool SkeletonHandler::string(string_t &val) { return this->skipped() || this->dom.string(val); }
+
+bool SkeletonHandler::binary(binary_t &val) { return this->skipped() || this->dom.binary(val); }
+
+bool SkeletonHandler::start_object(size_t elements) {
+    this->depth++;
+    return this->skipping || this->dom.start_object(elements);
+}
+
+/* workload keeps keys of resources, risk is kept as empty object */
+bool SkeletonHandler::key(string_t &val) {
+    if (this->skipping) return true;
+    if (this->depth == 1) this->interventions = val == INTERVENTIONS;
+    if (this->depth == 3) {
+        this->workload = val == WORKLOAD;
+        this->risk = val == RISK;
+    }
+    if (this->interventions && ((this->workload && this->depth == 5) || (this->risk && this->depth == 4))) {
+        this->skipping = true;
+        this->skip_depth = this->depth;
+        return true;
+    }
+    return this->dom.key(val);
+}
+
+bool SkeletonHandler::end_object() {
+    this->depth--;
+    return this->skipped() || this->dom.end_object();
+}
+
+bool SkeletonHandler::start_array(size_t elements) {
+    this->depth++;
+    return this->skipping || this->dom.start_array(elements);
+}
+
+bool SkeletonHandler::end_array() {
+    this->depth--;
+    return this->skipped() || this->dom.end_array();
+}
+
+bool SkeletonHandler::parse_error(size_t position, const std::string &last_token, const nlohmann::detail::exception &ex) {
+    return false;
+}
+
+StreamHandler::StreamHandler(Instance *instance) : instance(instance) {}
+
+/* number is stored only if it is a workload or a risk of a scenario inside the window of the start time */
+void StreamHandler::store(fitness_t value) {
+    if (!this->interventions || this->depth != 6) return;
+    if (this->workload) {
+        this->instance->add_r(this->intervention, this->start, this->resource, this->horizon, value);
+    } else if (this->risk && this->row.size() < this->scenarios) {
+        this->row.push_back(value);
+    }
+}
+
+bool StreamHandler::null() { return true; }
+
+bool StreamHandler::boolean(bool val) { return true; }
+
+bool StreamHandler::number_integer(number_integer_t val) {
+    this->store((fitness_t)val);
+    return true;
+}
+
+bool StreamHandler::number_unsigned(number_unsigned_t val) {
+    this->store((fitness_t)val);
+    return true;
+}
+
+bool StreamHandler::number_float(number_float_t val, const string_t &s) {
+    this->store((fitness_t)val);
+    return true;
+}
+
+bool StreamHandler::string(string_t &val) { return true; }
+
+bool StreamHandler::binary(binary_t &val) { return true; }
+
+bool StreamHandler::start_object(size_t elements) {
+    this->depth++;
+    return true;
+}
+
+/* depth of keys: 1 sections, 2 interventions, 3 items of intervention, 4-6 resource, horizon and start time of workload or horizon and start time of risk */
+bool StreamHandler::key(string_t &val) {
+    switch (this->depth) {
+        case 1:
+            this->interventions = val == INTERVENTIONS;
+            break;
+        case 2:
+            if (this->interventions) this->intervention = this->instance->get_intervention_id(val);
+            break;
+        case 3:
+            this->workload = val == WORKLOAD;
+            this->risk = val == RISK;
+            break;
+        case 4:
+            if (this->workload) this->resource = this->instance->get_resource_id(val);
+            else if (this->risk) this->horizon = key_to_horizon(val);
+            break;
+        case 5:
+            if (this->workload) this->horizon = key_to_horizon(val);
+            else if (this->risk) this->start = key_to_horizon(val);
+            break;
+        case 6:
+            if (this->workload) this->start = key_to_horizon(val);
+            break;
+    }
+    return true;
+}
+
+bool StreamHandler::end_object() {
+    this->depth--;
+    return true;
+}
+
+/* array of scenarios of risk row */
+bool StreamHandler::start_array(size_t elements) {
+    this->depth++;
+    if (this->interventions && this->risk && this->depth == 6) {
+        this->row.clear();
+        this->scenarios = 0;
+        if (this->instance->in_window(this->intervention, this->start, this->horizon)) {
+            this->scenarios = this->instance->get_scenarios(this->horizon);
+        }
+    }
+    return true;
+}
+
+/* complete row is stored at once, missing scenarios are zero */
+bool StreamHandler::end_array() {
+    if (this->interventions && this->risk && this->depth == 6 && this->scenarios > 0) {
+        this->row.resize(this->scenarios, 0.0);
+        this->instance->set_risk_row(this->intervention, this->start, this->horizon, this->row.data());
+    }
+    this->depth--;
+    return true;
+}
+
+bool StreamHandler::parse_error(size_t position, const std::string &last_token, const nlohmann::detail::exception &ex) {
+    return false;
 }
 
 /* extracts exclusions from json and maps pair of instances to row index in season table */
@@ -144,6 +397,7 @@ void Parser::process_exclusions(Instance *instance) {
             seas_names[season_comb] = count++;
         }
     }
+    instance->compile_exclusions();
 }
 
 bool cmp_pair(pair<uint_t, fitness_t>& a,
@@ -153,41 +407,60 @@ bool cmp_pair(pair<uint_t, fitness_t>& a,
 }
 
 void Parser::process_avg_properties(Instance *instance) {
+    /* the sweep below is skipped if the properties were already computed for the same content */
+    ullint_t hash = 0;
+    if (INSTANCE_CACHE) {
+        hash = instance->content_hash();
+        if (instance->load_avg_properties(this->path_to_file + AVG_CACHE_SUFFIX, hash)) return;
+    }
     vector<pair<uint_t, fitness_t>> avg_deltas;
     vector<pair<uint_t, fitness_t>> avg_costs;
     vector<pair<uint_t, fitness_t>> avg_rds;
 
-    std::default_random_engine engine(1);
-    Solution s(instance, &engine);
+    const uint_vector_t &interventions = instance->get_interventions();
+    vector<fitness_t> delta_avgs(interventions.size());
+    vector<fitness_t> cost_avgs(interventions.size());
+    vector<fitness_t> rd_avgs(interventions.size());
 
-    for (auto i:instance->get_interventions()) {
-        // cout << "i: " << i << endl;
-        auto delta_idx = instance->get_delta_index(i, 1);
-        auto t_max = instance->get_t_max(i);
+    /* every thread estimates on its own empty solution */
+    #pragma omp parallel
+    {
+        std::default_random_engine engine(1);
+        Solution s(instance, &engine);
+        vector<Objective> objectives;
 
-        fitness_t delta_avg = 0;
-        fitness_t cost_avg = 0;
-        fitness_t rd_avg = 0;
+        #pragma omp for schedule(dynamic)
+        for (uint_t idx = 0; idx < interventions.size(); ++idx) {
+            auto i = interventions[idx];
+            auto delta_idx = instance->get_delta_index(i, 1);
+            auto t_max = instance->get_t_max(i);
 
-        for (uint_t t = 1; t <= t_max; ++t) {
-            auto delta = instance->delta[delta_idx++];
-            auto obj = s.estimate_schedule(i, t);
-            auto cost = obj.final_objective;
-            auto rd = obj.total_resource_use;
-            // cout << "t: " << t << ", delta: " << delta << ", cost: " << cost << ", rd: " << rd << endl;
+            fitness_t delta_avg = 0;
+            fitness_t cost_avg = 0;
+            fitness_t rd_avg = 0;
 
-            delta_avg += delta;
-            cost_avg += cost;
-            rd_avg += rd;
-        }
+            s.estimate_schedule_times(i, objectives);
+            for (uint_t t = 1; t <= t_max; ++t) {
+                auto delta = instance->delta[delta_idx++];
+                auto &obj = objectives[t];
+                auto cost = obj.final_objective;
+                auto rd = obj.total_resource_use;
 
-        delta_avg /= t_max;
-        cost_avg /= t_max;
-        rd_avg /= t_max;
+                delta_avg += delta;
+                cost_avg += cost;
+                rd_avg += rd;
+            }
 
-        avg_deltas.emplace_back(i, delta_avg);
-        avg_costs.emplace_back(i, cost_avg);
-        avg_rds.emplace_back(i, rd_avg);
+            delta_avgs[idx] = delta_avg / t_max;
+            cost_avgs[idx] = cost_avg / t_max;
+            rd_avgs[idx] = rd_avg / t_max;
+        }
+    }
+
+    for (uint_t idx = 0; idx < interventions.size(); ++idx) {
+        avg_deltas.emplace_back(interventions[idx], delta_avgs[idx]);
+        avg_costs.emplace_back(interventions[idx], cost_avgs[idx]);
+        avg_rds.emplace_back(interventions[idx], rd_avgs[idx]);
     }
 
     sort(avg_deltas.begin(), avg_deltas.end(), cmp_pair);
@@ -197,4 +470,42 @@ void Parser::process_avg_properties(Instance *instance) {
     instance->set_avg_deltas(avg_deltas);
     instance->set_avg_costs(avg_costs);
     instance->set_avg_rds(avg_rds);
-}
\ No newline at end of file
+    if (INSTANCE_CACHE) instance->save_avg_properties(this->path_to_file + AVG_CACHE_SUFFIX, hash);
+}
+
+#ifdef REDUCED_PRECISION
+/* every start time of every intervention is estimated on an empty solution and compared with the objective computed in double */
+void Parser::validate_precision(Instance *instance) {
+    const uint_vector_t &interventions = instance->get_interventions();
+    fitness_t max_objective = 0.0;
+    fitness_t max_relative_objective = 0.0;
+    fitness_t max_resource_use = 0.0;
+    fitness_t max_relative_resource_use = 0.0;
+
+    #pragma omp parallel reduction(max: max_objective, max_relative_objective, max_resource_use, max_relative_resource_use)
+    {
+        std::default_random_engine engine(1);
+        Solution s(instance, &engine);
+        vector<Objective> objectives;
+
+        #pragma omp for schedule(dynamic)
+        for (uint_t idx = 0; idx < interventions.size(); ++idx) {
+            uint_t i = interventions[idx];
+            s.estimate_schedule_times(i, objectives);
+            for (uint_t t = 1; t <= instance->get_t_max(i); ++t) {
+                fitness_t reference = instance->get_reference_objective(i, t);
+                fitness_t deviation = abs(objectives[t].final_objective - reference);
+                max_objective = max(max_objective, deviation);
+                if (reference != 0.0) max_relative_objective = max(max_relative_objective, deviation / abs(reference));
+                reference = instance->get_reference_resource_use(i, t);
+                deviation = abs(objectives[t].total_resource_use - reference);
+                max_resource_use = max(max_resource_use, deviation);
+                if (reference != 0.0) max_relative_resource_use = max(max_relative_resource_use, deviation / abs(reference));
+            }
+        }
+    }
+    cout << "Reduced precision: max objective deviation " << max_objective << " (relative " << max_relative_objective << ")"
+         << ", max resource use deviation " << max_resource_use << " (relative " << max_relative_resource_use << ")" << endl;
+    instance->clear_reference();
+}
+#endif
@@ -6,24 +6,99 @@
 #include "json.hpp"
 #include "../instance/instance.hpp"
 #include "json_objnames.hpp"
-#include "../ranges.hpp"
 #include "../util.hpp"
 #include "../types.hpp"
 
 using namespace std;
 using json = nlohmann::json;
 
+/* SAX handler that builds json object of the file without values of workloads and risks of interventions */
+class SkeletonHandler : public nlohmann::json_sax<json> {
+    private:
+        nlohmann::detail::json_sax_dom_parser<json> dom; /* builds object from events that are not skipped */
+        uint_t depth = 0; /* nesting of objects and arrays */
+        bool interventions = false; /* inside object of interventions */
+        bool workload = false; /* inside workload of intervention */
+        bool risk = false; /* inside risk of intervention */
+        bool skipping = false; /* inside value of skipped key */
+        uint_t skip_depth = 0; /* depth of the skipped key */
+        bool skipped(); /* true if event belongs to skipped value */
+    public:
+        SkeletonHandler(json &j);
+        bool null() override;
+        bool boolean(bool val) override;
+        bool number_integer(number_integer_t val) override;
+        bool number_unsigned(number_unsigned_t val) override;
+        bool number_float(number_float_t val, const string_t &s) override;
+        bool string(string_t &val) override;
+        bool binary(binary_t &val) override;
+        bool start_object(size_t elements) override;
+        bool key(string_t &val) override;
+        bool end_object() override;
+        bool start_array(size_t elements) override;
+        bool end_array() override;
+        bool parse_error(size_t position, const std::string &last_token, const nlohmann::detail::exception &ex) override;
+};
+
+/*
+ * SAX handler that stores workloads and risks of interventions straight to instance arrays as the values are read,
+ * windows of interventions have to be allocated before (see Parser::stream)
+ */
+class StreamHandler : public nlohmann::json_sax<json> {
+    private:
+        Instance *instance;
+        uint_t depth = 0; /* nesting of objects and arrays */
+        bool interventions = false; /* inside object of interventions */
+        bool workload = false; /* inside workload of intervention */
+        bool risk = false; /* inside risk of intervention */
+        uint_t intervention = 0;
+        uint_t resource = 0;
+        uint_t horizon = 0;
+        uint_t start = 0;
+        uint_t scenarios = 0; /* scenarios of current risk row, 0 when the row is out of the window */
+        vector<fitness_t> row; /* values of current risk row read so far */
+        void store(fitness_t value);
+    public:
+        StreamHandler(Instance *instance);
+        bool null() override;
+        bool boolean(bool val) override;
+        bool number_integer(number_integer_t val) override;
+        bool number_unsigned(number_unsigned_t val) override;
+        bool number_float(number_float_t val, const string_t &s) override;
+        bool string(string_t &val) override;
+        bool binary(binary_t &val) override;
+        bool start_object(size_t elements) override;
+        bool key(string_t &val) override;
+        bool end_object() override;
+        bool start_array(size_t elements) override;
+        bool end_array() override;
+        bool parse_error(size_t position, const std::string &last_token, const nlohmann::detail::exception &ex) override;
+};
+
 /* hanles parsing json file and storing the values to instance object */
 class Parser {
     private:
         const string path_to_file; /* path to parsed json file */
         json j; /* library object which parses the file */
+        void process_data(Instance *instance); /* extracts everything held by j, workloads and risks are stored only if j holds them */
+        void process_derived(Instance *instance); /* computes properties that need all workloads and risks to be stored */
         void process_exclusions(Instance *instance); /* extracts exclusions from json to Instance object */
-        static void process_avg_properties(Instance *instance); /* determine average values of some intervention properties */
+        void process_avg_properties(Instance *instance); /* determine average values of some intervention properties */
+#ifdef REDUCED_PRECISION
+        void validate_precision(Instance *instance); /* reports deviation of objectives evaluated from rounded values */
+#endif
+        bool source_stamp(ullint_t &size, ullint_t &time); /* size and modification time of the json file */
     public:
         Parser(string path_to_file);
         void load(); /* reads file and fills j object */
         void process(Instance *instance); /* reads j object and translates data to instance object */
+        /*
+         * reads file without holding workloads and risks in j, the first pass keeps everything else in j,
+         * the second pass stores workloads and risks straight to the instance
+         */
+        void stream(Instance *instance);
+        bool load_binary(Instance *instance); /* fills instance from binary image of the json file if there is a valid one */
+        void save_binary(Instance *instance); /* stores processed instance as binary image next to the json file */
 };
 
 #endif
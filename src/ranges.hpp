@@ -1,16 +0,0 @@
-#ifndef RANGES_H
-#define RANGES_H
-
-#define MAX_INTERVENTIONS (1000)
-#define MAX_HORIZONS (365)
-#define MAX_RESOURCES (15)
-
-#define PROD_RT (5475)
-#define PROD_IT (365000)
-#define PROD_ITR (5475000)
-#define PROD_ITRT (1998375000)
-#define PROD_ITT (133225000)
-#define PROD_TRT (1998375)
-#define PROD_TT (133225)
-
-#endif
@@ -1,14 +1,25 @@
 #include "removals.hpp"
 
+/* estimates of unscheduling are independent and read-only, so they are evaluated in parallel and reduced in order afterwards */
+static void estimate_unschedules(Solution &solution, const uint_vector_t &interventions, vector<Objective> &estimates) {
+    estimates.resize(interventions.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (int idx = 0; idx < interventions.size(); ++idx) {
+        estimates[idx] = solution.estimate_unschedule(interventions[idx]);
+    }
+}
+
 /*
  * Find the most expensive scheduled intervention and unschedule it.
  */
 void most_expensive_remove(Solution &solution) {
-    Objective o;
+    vector<Objective> estimates;
+    uint_t idx = 0;
     fitness_t highest_decrease = numeric_limits<fitness_t>::max();
     uint_t i;
+    estimate_unschedules(solution, solution.scheduled, estimates);
     for (uint_t si : solution.scheduled) {
-        o = solution.estimate_unschedule(si);
+        const Objective &o = estimates[idx++];
         if (o.extended_objective < highest_decrease) {
             i = si;
             highest_decrease = o.extended_objective;
@@ -39,11 +50,13 @@ void random_remove(Solution &solution) {
  * Find the intervention with the highest resource demand (=highest decrease on unschedule in total resource demand) and unschedule it.
  */
 void hrd_remove(Solution &solution) {
-    Objective o;
+    vector<Objective> estimates;
+    uint_t idx = 0;
     fitness_t highest_decrease = numeric_limits<fitness_t>::max();
     uint_t i;
+    estimate_unschedules(solution, solution.scheduled, estimates);
     for (uint_t si : solution.scheduled) {
-        o = solution.estimate_unschedule(si);
+        const Objective &o = estimates[idx++];
         if (o.total_resource_use < highest_decrease) {
             i = si;
             highest_decrease = o.total_resource_use;
@@ -121,11 +134,13 @@ void shortest_remove(Solution &solution) {
 }
 
 void cheapest_remove(Solution &solution) {
-    Objective o;
+    vector<Objective> estimates;
+    uint_t idx = 0;
     fitness_t lowest_decrease = 0;
     uint_t i;
+    estimate_unschedules(solution, solution.scheduled, estimates);
     for (uint_t si : solution.scheduled) {
-        o = solution.estimate_unschedule(si);
+        const Objective &o = estimates[idx++];
         if (o.extended_objective > lowest_decrease) {
             i = si;
             lowest_decrease = o.extended_objective;
@@ -143,11 +158,13 @@ void cheapest_remove(Solution &solution) {
  * Find the intervention with the highest resource demand (=highest decrease on unschedule in total resource demand) and unschedule it.
  */
 void lrd_remove(Solution &solution) {
-    Objective o;
+    vector<Objective> estimates;
+    uint_t idx = 0;
     fitness_t lowest_decrease = numeric_limits<fitness_t>::max();
     uint_t cand_i;
-    for (uint_t si:solution.scheduled) {
-        o = solution.estimate_unschedule(si);
+    estimate_unschedules(solution, solution.scheduled, estimates);
+    for (uint_t si : solution.scheduled) {
+        const Objective &o = estimates[idx++];
         if (o.total_resource_use < lowest_decrease) {
             cand_i = si;
             lowest_decrease = o.total_resource_use;
@@ -232,3 +249,66 @@ void most_used_remove(Solution &solution) {
     solution.unscheduled_cnt[i_cand]++;
 
 }
+
+/*
+ * Unschedule count interventions one by one, each with the highest (or lowest) value of the property after its unscheduling.
+ * Values are kept as changes of the property in a heap, unscheduling changes only values of interventions whose windows
+ * overlap the window of the unscheduled one (exclusions are counted only in common horizons), so only these are estimated again
+ * and their outdated heap items are skipped when popped. Ties are broken by lower id as in the methods removing one intervention.
+ */
+void batch_property_remove(Solution &solution, uint_t count, const string &property, bool highest) {
+    uint_t i;
+    uint_t start;
+    uint_t end;
+    uint_vector_t overlapping;
+    vector<Objective> estimates;
+    vector<fitness_t> values(solution.instance->get_intervention_count() + 1, 0.0);
+    vector<pair<fitness_t, uint_t>> heap;
+    auto lower = [](const pair<fitness_t, uint_t> &a, const pair<fitness_t, uint_t> &b) {
+        return a.first < b.first || (a.first == b.first && a.second > b.second);
+    };
+    auto estimate = [&](const uint_vector_t &interventions) {
+        estimate_unschedules(solution, interventions, estimates);
+        for (uint_t idx = 0; idx < interventions.size(); ++idx) {
+            uint_t si = interventions[idx];
+            if (property == "cost") {
+                values[si] = estimates[idx].extended_objective - solution.extended_objective;
+            } else if (property == "rd") {
+                values[si] = estimates[idx].total_resource_use - solution.total_resource_use;
+            } else {
+                cerr << "UNKNOWN_PROPERTY: " << property << endl;
+                exit(1);
+            }
+            if (!highest) values[si] = -values[si];
+            heap.emplace_back(values[si], si);
+            push_heap(heap.begin(), heap.end(), lower);
+        }
+    };
+    estimate(solution.scheduled);
+    for (uint_t removed = 0; removed < count; ++removed) {
+        /* skip items of unscheduled interventions and items replaced by newer estimates */
+        bool current = false;
+        while (!current && !heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), lower);
+            i = heap.back().second;
+            current = solution.is_scheduled(i) && values[i] == heap.back().first;
+            heap.pop_back();
+        }
+        if (!current) break;
+        start = solution.get_start_time(i);
+        end = solution.instance->get_descriptor(i, start).end;
+        #if VERBOSE_HEURISTICS
+        cerr << "BATCH_REMOVE(property = " << property << ", highest = " << highest << "): removed intervention " << solution.instance->get_intervention(i) << endl;
+        #endif
+        solution.unschedule(i);
+        solution.unscheduled_cnt[i]++;
+        /* resource demand of an intervention does not depend on the others */
+        if (property == "rd") continue;
+        overlapping.clear();
+        for (uint_t si : solution.scheduled) {
+            uint_t start2 = solution.get_start_time(si);
+            if (start2 < end && start < solution.instance->get_descriptor(si, start2).end) overlapping.push_back(si);
+        }
+        estimate(overlapping);
+    }
+}
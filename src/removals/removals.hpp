@@ -4,6 +4,8 @@
 #include <limits>
 #include <string>
 #include <string.h>
+#include <algorithm>
+#include <omp.h>
 #include "../solution/solution.hpp"
 #include "../solution/objective.hpp"
 #include "../types.hpp"
@@ -27,4 +29,11 @@ void least_exclusions_remove(Solution &solution);
 void least_used_remove(Solution &solution);
 void most_used_remove(Solution &solution);
 
+/* batches removing count interventions at once with the same choices as count calls of the methods above */
+void batch_property_remove(Solution &solution, uint_t count, const string &property, bool highest);
+inline void cheapest_batch_remove(Solution &solution, uint_t count) {batch_property_remove(solution, count, "cost", true);}
+inline void most_expensive_batch_remove(Solution &solution, uint_t count) {batch_property_remove(solution, count, "cost", false);}
+inline void lrd_batch_remove(Solution &solution, uint_t count) {batch_property_remove(solution, count, "rd", false);}
+inline void hrd_batch_remove(Solution &solution, uint_t count) {batch_property_remove(solution, count, "rd", false);}
+
 #endif //ROADEF_REMOVALS_H
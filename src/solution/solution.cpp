@@ -1,11 +1,300 @@
 #include "solution.hpp"
 
+atomic<ullint_t> Solution::versions(0);
+
+/* per thread buffer for selecting quantiles, reallocated only when more scenarios are needed than ever before */
+static fitness_t *scenario_buffer(uint_t size) {
+    static thread_local vector<fitness_t> buffer;
+    if (buffer.size() < size) buffer.resize(size);
+    return buffer.data();
+}
+
+/* per thread buffer for contributions of horizons to objectives, see estimate_schedule_times */
+static fitness_t *horizon_buffer(uint_t size) {
+    static thread_local vector<fitness_t> buffer;
+    if (buffer.size() < size) buffer.resize(size);
+    return buffer.data();
+}
+
+/* order of sums of changes in a window of one resource computed by window kernels */
+#define WINDOW_UNDERUSE 0 /* decrease of underuse on schedule, increase on unschedule */
+#define WINDOW_OVERUSE 1 /* increase of overuse on schedule, decrease on unschedule */
+#define WINDOW_TOTAL 2
+#define WINDOW_SUMS 3
+
+/*
+ * adds changes of underuse, overuse and total workload caused by adding (removing) workloads to use of one resource in consecutive
+ * horizons to sums, use after the change is written to new_use unless it is null (it may be the same array as use)
+ */
+typedef void (*window_kernel_t)(const fitness_t *use, const half_fitness_t *workload, const fitness_t *u, const fitness_t *l, uint_t length, fitness_t *sums, fitness_t *new_use);
+
+template<bool removal> static void window_scalar(const fitness_t *use, const half_fitness_t *workload, const fitness_t *u, const fitness_t *l, uint_t length, fitness_t *sums, fitness_t *new_use) {
+    fitness_t before;
+    fitness_t after;
+    fitness_t value;
+    for (uint_t i = 0; i < length; ++i) {
+        before = use[i];
+        value = workload[i];
+        after = removal ? before - value : before + value;
+        if (removal) {
+            if (after < l[i] - NUMERIC_TOLERANCE) sums[WINDOW_UNDERUSE] += before < l[i] ? value : l[i] - after;
+            if (before > u[i]) sums[WINDOW_OVERUSE] += after > u[i] + NUMERIC_TOLERANCE ? value : before - u[i];
+        } else {
+            if (before < l[i]) sums[WINDOW_UNDERUSE] += after < l[i] - NUMERIC_TOLERANCE ? value : l[i] - before;
+            if (after > u[i] + NUMERIC_TOLERANCE) sums[WINDOW_OVERUSE] += before > u[i] ? value : after - u[i];
+        }
+        sums[WINDOW_TOTAL] += value;
+        if (new_use) new_use[i] = after;
+    }
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) static inline __m256d load_workload4(const double *workload, __m256i mask) { return _mm256_maskload_pd(workload, mask); }
+__attribute__((target("avx2"))) static inline __m256d load_workload4(const float *workload, __m256i mask) {
+    return _mm256_cvtps_pd(_mm_maskload_ps(workload, _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(mask, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)))));
+}
+
+__attribute__((target("avx2"))) static inline double sum4(__m256d v) {
+    __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+/*
+ * branches of the scalar kernel are replaced by masks, the last vector is loaded with mask of horizons inside the window
+ * (calling the scalar kernel for the rest would run legacy SSE code with dirty upper halves of registers)
+ */
+template<bool removal> __attribute__((target("avx2"))) static void window_avx2(const double *use, const half_fitness_t *workload, const double *u, const double *l, uint_t length, double *sums, double *new_use) {
+    const __m256d tolerance = _mm256_set1_pd(NUMERIC_TOLERANCE);
+    const __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+    __m256d under = _mm256_setzero_pd();
+    __m256d over = _mm256_setzero_pd();
+    __m256d total = _mm256_setzero_pd();
+    __m256d before, after, value, max, min, low, was_low, high, was_high, inside;
+    __m256i mask;
+    for (uint_t i = 0; i < length; i += 4) {
+        mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(length - i), lanes);
+        inside = _mm256_castsi256_pd(mask);
+        before = _mm256_maskload_pd(use + i, mask);
+        value = load_workload4(workload + i, mask);
+        max = _mm256_maskload_pd(u + i, mask);
+        min = _mm256_maskload_pd(l + i, mask);
+        after = removal ? _mm256_sub_pd(before, value) : _mm256_add_pd(before, value);
+        low = _mm256_and_pd(inside, _mm256_cmp_pd(after, _mm256_sub_pd(min, tolerance), _CMP_LT_OQ));
+        was_low = _mm256_and_pd(inside, _mm256_cmp_pd(before, min, _CMP_LT_OQ));
+        high = _mm256_and_pd(inside, _mm256_cmp_pd(after, _mm256_add_pd(max, tolerance), _CMP_GT_OQ));
+        was_high = _mm256_and_pd(inside, _mm256_cmp_pd(before, max, _CMP_GT_OQ));
+        if (removal) {
+            under = _mm256_add_pd(under, _mm256_and_pd(low, _mm256_blendv_pd(_mm256_sub_pd(min, after), value, was_low)));
+            over = _mm256_add_pd(over, _mm256_and_pd(was_high, _mm256_blendv_pd(_mm256_sub_pd(before, max), value, high)));
+        } else {
+            under = _mm256_add_pd(under, _mm256_and_pd(was_low, _mm256_blendv_pd(_mm256_sub_pd(min, before), value, low)));
+            over = _mm256_add_pd(over, _mm256_and_pd(high, _mm256_blendv_pd(_mm256_sub_pd(after, max), value, was_high)));
+        }
+        total = _mm256_add_pd(total, value);
+        if (new_use) _mm256_maskstore_pd(new_use + i, mask, after);
+    }
+    sums[WINDOW_UNDERUSE] += sum4(under);
+    sums[WINDOW_OVERUSE] += sum4(over);
+    sums[WINDOW_TOTAL] += sum4(total);
+}
+
+__attribute__((target("avx512f"))) static inline __m512d load_workload8(const double *workload, __mmask8 mask) { return _mm512_maskz_loadu_pd(mask, workload); }
+__attribute__((target("avx512f"))) static inline __m512d load_workload8(const float *workload, __mmask8 mask) { return _mm512_cvtps_pd(_mm512_castps512_ps256(_mm512_maskz_loadu_ps(mask, workload))); }
+
+/* as the AVX2 kernel, the last vector is masked, so there is no scalar tail */
+template<bool removal> __attribute__((target("avx512f"))) static void window_avx512(const double *use, const half_fitness_t *workload, const double *u, const double *l, uint_t length, double *sums, double *new_use) {
+    const __m512d tolerance = _mm512_set1_pd(NUMERIC_TOLERANCE);
+    __m512d under = _mm512_setzero_pd();
+    __m512d over = _mm512_setzero_pd();
+    __m512d total = _mm512_setzero_pd();
+    __m512d before, after, value, max, min;
+    __mmask8 mask, low, was_low, high, was_high;
+    for (uint_t i = 0; i < length; i += 8) {
+        mask = length - i >= 8 ? 0xFF : (__mmask8)((1u << (length - i)) - 1);
+        before = _mm512_maskz_loadu_pd(mask, use + i);
+        value = load_workload8(workload + i, mask);
+        max = _mm512_maskz_loadu_pd(mask, u + i);
+        min = _mm512_maskz_loadu_pd(mask, l + i);
+        after = removal ? _mm512_sub_pd(before, value) : _mm512_add_pd(before, value);
+        low = _mm512_mask_cmp_pd_mask(mask, after, _mm512_sub_pd(min, tolerance), _CMP_LT_OQ);
+        was_low = _mm512_mask_cmp_pd_mask(mask, before, min, _CMP_LT_OQ);
+        high = _mm512_mask_cmp_pd_mask(mask, after, _mm512_add_pd(max, tolerance), _CMP_GT_OQ);
+        was_high = _mm512_mask_cmp_pd_mask(mask, before, max, _CMP_GT_OQ);
+        if (removal) {
+            under = _mm512_mask_add_pd(under, low, under, _mm512_mask_blend_pd(was_low, _mm512_sub_pd(min, after), value));
+            over = _mm512_mask_add_pd(over, was_high, over, _mm512_mask_blend_pd(high, _mm512_sub_pd(before, max), value));
+        } else {
+            under = _mm512_mask_add_pd(under, was_low, under, _mm512_mask_blend_pd(low, _mm512_sub_pd(min, before), value));
+            over = _mm512_mask_add_pd(over, high, over, _mm512_mask_blend_pd(was_high, _mm512_sub_pd(after, max), value));
+        }
+        total = _mm512_add_pd(total, value);
+        if (new_use) _mm512_mask_storeu_pd(new_use + i, mask, after);
+    }
+    sums[WINDOW_UNDERUSE] += _mm512_reduce_add_pd(under);
+    sums[WINDOW_OVERUSE] += _mm512_reduce_add_pd(over);
+    sums[WINDOW_TOTAL] += _mm512_reduce_add_pd(total);
+}
+
+#endif
+
+/* vector kernels are chosen once by the features of the CPU the program runs on, they work only with double objectives */
+template<bool removal> static window_kernel_t select_window_kernel() {
+#if defined(__x86_64__)
+    if constexpr (std::is_same<fitness_t, double>::value) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return window_avx512<removal>;
+        if (__builtin_cpu_supports("avx2")) return window_avx2<removal>;
+    }
+#endif
+    return window_scalar<removal>;
+}
+
+static const window_kernel_t add_window = select_window_kernel<false>();
+static const window_kernel_t remove_window = select_window_kernel<true>();
+
+/* number of scenarios ranked on the side of the quantile, the tail keeps QUANTILE_TAIL times more of them */
+static uint_t tail_length(uint_t size, uint_t k, bool &upper) {
+    upper = 2 * k >= size;
+    return min(size, QUANTILE_TAIL * (upper ? size - k : k + 1));
+}
+
+/* selects k-th smallest cumulative risk and keeps the tail of scenarios with the highest (lowest for quantiles under
+   median) risks, the previous tail bounds the new one as (un)scheduling moves the risks only by one risk row */
+static fitness_t track_quantile(const fitness_t *risks, uint_t size, uint_t k, uint_t *tail) {
+    bool upper;
+    uint_t length = tail_length(size, k, upper);
+    uint_t *idx = reinterpret_cast<uint_t *>(scenario_buffer(size));
+    uint_t count = 0;
+    fitness_t bound = risks[tail[0]];
+    auto by_risk = [risks](uint_t a, uint_t b) { return risks[a] < risks[b]; };
+    for (uint_t i = 1; i < length; ++i) bound = upper ? min(bound, risks[tail[i]]) : max(bound, risks[tail[i]]);
+    if (upper) {
+        for (uint_t s = 0; s < size; ++s) {
+            idx[count] = s;
+            count += risks[s] >= bound;
+        }
+        nth_element(idx, idx + count - length, idx + count, by_risk);
+        copy(idx + count - length, idx + count, tail);
+        k -= size - length;
+    } else {
+        for (uint_t s = 0; s < size; ++s) {
+            idx[count] = s;
+            count += risks[s] <= bound;
+        }
+        nth_element(idx, idx + length - 1, idx + count, by_risk);
+        copy(idx, idx + length, tail);
+    }
+    nth_element(tail, tail + k, tail + length, by_risk);
+    return risks[tail[k]];
+}
+
+/* k-th smallest of changed cumulative risks, the changed risks of the tail give a bound that the quantile cannot cross,
+   so nth_element runs only on the few scenarios beyond the bound */
+static fitness_t select_quantile(fitness_t *changed, uint_t size, uint_t k, const uint_t *tail, fitness_t *candidates) {
+    bool upper;
+    uint_t length = tail_length(size, k, upper);
+    uint_t need = upper ? size - k : k + 1;
+    uint_t count = 0;
+    uint_t beyond = 0;
+    fitness_t bound;
+    if (length == size) {
+        nth_element(changed, changed + k, changed + size);
+        return changed[k];
+    }
+    for (; count < length; ++count) candidates[count] = changed[tail[count]];
+    if (upper) {
+        /* at least need scenarios are at the bound or above, so the quantile is too */
+        nth_element(candidates, candidates + length - need, candidates + length);
+        bound = candidates[length - need];
+        for (uint_t s = 0; s < size; ++s) {
+            candidates[beyond] = changed[s];
+            beyond += changed[s] >= bound;
+        }
+        k -= size - beyond;
+    } else {
+        nth_element(candidates, candidates + need - 1, candidates + length);
+        bound = candidates[need - 1];
+        for (uint_t s = 0; s < size; ++s) {
+            candidates[beyond] = changed[s];
+            beyond += changed[s] <= bound;
+        }
+    }
+    nth_element(candidates, candidates + k, candidates + beyond);
+    return candidates[k];
+}
+
+/*
+ * risk kernels of one horizon, k-th smallest of cumulative risks (indexed from 1, item 0 is zero) after the risk row
+ * is added (removed), kernel of horizon is chosen by its scenario count (see Instance::get_scenario_kernel)
+ */
+typedef fitness_t (*risk_kernel_t)(const fitness_t *risks, const half_fitness_t *row, uint_t scenarios, uint_t k, const uint_t *tail);
+/* k-th smallest of changed cumulative risks of one horizon, changed risks are reordered */
+typedef fitness_t (*select_kernel_t)(fitness_t *changed, uint_t size, uint_t k, const uint_t *tail, fitness_t *candidates);
+
+#define SCENARIO_BLOCK 8 /* scenarios changed at once by kernels of horizons with many scenarios */
+
+/* odd-even transposition network, with size known at compile time it is unrolled to branchless min and max */
+template<uint_t size> static inline void sort_network(fitness_t *values) {
+    #pragma GCC unroll 32
+    for (uint_t round = 0; round < size; ++round) {
+        #pragma GCC unroll 32
+        for (uint_t i = round % 2; i + 1 < size; i += 2) {
+            fitness_t low = std::min(values[i], values[i + 1]);
+            values[i + 1] = std::max(values[i], values[i + 1]);
+            values[i] = low;
+        }
+    }
+}
+
+/* few scenarios are sorted whole, the tail is not needed */
+template<uint_t scenarios> static fitness_t select_small(fitness_t *changed, uint_t size, uint_t k, const uint_t *tail, fitness_t *candidates) {
+    sort_network<scenarios + 1>(changed);
+    return changed[k];
+}
+
+template<bool removal, uint_t scenarios> static fitness_t risk_small(const fitness_t *risks, const half_fitness_t *row, uint_t size, uint_t k, const uint_t *tail) {
+    fitness_t changed[scenarios + 1];
+    changed[0] = risks[0];
+    #pragma GCC unroll 32
+    for (uint_t s = 1; s <= scenarios; ++s) changed[s] = removal ? risks[s] - row[TO_INDEX(s)] : risks[s] + row[TO_INDEX(s)];
+    sort_network<scenarios + 1>(changed);
+    return changed[k];
+}
+
+/* scenarios are changed in blocks of fixed width that vectorize without runtime trip count, the rest one by one */
+template<bool removal> static fitness_t risk_blocked(const fitness_t *risks, const half_fitness_t *row, uint_t scenarios, uint_t k, const uint_t *tail) {
+    fitness_t *changed = scenario_buffer(2 * (scenarios + 1));
+    uint_t s = 1;
+    changed[0] = risks[0];
+    for (; s + SCENARIO_BLOCK <= scenarios + 1; s += SCENARIO_BLOCK) {
+        #pragma omp simd
+        for (uint_t b = 0; b < SCENARIO_BLOCK; ++b) {
+            changed[s + b] = removal ? risks[s + b] - row[TO_INDEX(s + b)] : risks[s + b] + row[TO_INDEX(s + b)];
+        }
+    }
+    for (; s <= scenarios; ++s) changed[s] = removal ? risks[s] - row[TO_INDEX(s)] : risks[s] + row[TO_INDEX(s)];
+    return select_quantile(changed, scenarios + 1, k, tail, changed + scenarios + 1);
+}
+
+/* tables indexed by kernel of horizon, 0 stands for horizons with more than SMALL_SCENARIOS scenarios */
+template<bool removal, size_t... scenarios> static constexpr array<risk_kernel_t, sizeof...(scenarios)> risk_kernels(index_sequence<scenarios...>) {
+    return {(scenarios == 0 ? risk_blocked<removal> : risk_small<removal, (scenarios > 0 ? scenarios : 1)>)...};
+}
+
+template<size_t... scenarios> static constexpr array<select_kernel_t, sizeof...(scenarios)> select_kernels(index_sequence<scenarios...>) {
+    return {(scenarios == 0 ? select_quantile : select_small<(scenarios > 0 ? scenarios : 1)>)...};
+}
+
+static const array<risk_kernel_t, SMALL_SCENARIOS + 1> add_row = risk_kernels<false>(make_index_sequence<SMALL_SCENARIOS + 1>());
+static const array<risk_kernel_t, SMALL_SCENARIOS + 1> remove_row = risk_kernels<true>(make_index_sequence<SMALL_SCENARIOS + 1>());
+static const array<select_kernel_t, SMALL_SCENARIOS + 1> select_row = select_kernels(make_index_sequence<SMALL_SCENARIOS + 1>());
+
 Solution::Solution(Instance *instance, std::default_random_engine *engine) {
     this->instance = instance;
     this->engine = engine;
-    for (uint_t intervention : instance->get_interventions()) {
-        this->unscheduled.insert(intervention);
-    }
+    this->start_times.resize(instance->get_intervention_count() + 1, 0);
+    this->unscheduled = instance->get_interventions();
+    sort(this->unscheduled.begin(), this->unscheduled.end());
     /* resize fields according to indexed value (indexing from 1 -> size + 1) */
     uint_t horizons = this->instance->get_horizon_num();
     /* initialize state variables to 0 */
@@ -25,14 +314,11 @@ Solution::Solution(Instance *instance, std::default_random_engine *engine) {
         this->exclusions_at_time.push_back(0);
     }
     uint_t resources = this->instance->get_resources().size();
-    vector<fitness_t> line_;
-    this->resource_use.push_back(line_);
+    this->resource_use.resize((ullint_t)resources * horizons, 0.0);
     this->resource_overuse.push_back(0.0);
     this->resource_underuse.push_back(0.0);
-    uint_t l_idx = 0;
+    ullint_t l_idx = 0;
     for (uint_t r = 1; r <= resources; ++r) {
-        vector<fitness_t> line(horizons + 1, 0.0);
-        this->resource_use.push_back(line);
         this->resource_overuse.push_back(0.0);
         this->resource_underuse.push_back(0.0);
         for (uint_t t = 1; t <= horizons; ++t) {
@@ -41,16 +327,47 @@ Solution::Solution(Instance *instance, std::default_random_engine *engine) {
             this->workload_underuse += l;
         }
     }
-    /* initialize risk_st, indexing from [1][1] */
-    vector<fitness_t> _line;
-    this->risk_st.push_back(_line);
+    /* initialize risk_st, row of each horizon has one more item to index scenarios from 1 */
+    this->risk_st.resize(this->instance->get_scenario_offset(horizons + 1) + horizons, 0.0);
+    this->tail_offsets.resize(horizons + 2, 0);
     for (uint_t t = 1; t <= horizons; ++t) {
-        vector<fitness_t> line(this->instance->get_scenarios(t) + 1, 0.0);
-        this->risk_st.push_back(line);
+        uint_t scenarios = this->instance->get_scenarios(t);
+        bool upper;
+        this->tail_offsets[t + 1] = this->tail_offsets[t] + tail_length(scenarios + 1, this->instance->get_quantile_index(t), upper);
+    }
+    /* any scenarios bound the tails while all risks are zero */
+    this->quantile_tails.resize(this->tail_offsets[horizons + 1]);
+    for (uint_t t = 1; t <= horizons; ++t) {
+        uint_t scenarios = this->instance->get_scenarios(t);
+        uint_t *tail = this->get_quantile_tail(t);
+        iota(tail, this->get_quantile_tail(t + 1), 0);
+        track_quantile(this->get_risk_st(t), scenarios + 1, this->instance->get_quantile_index(t), tail);
     }
     this->extended_objective = BETA_LOWER * this->workload_underuse;
     this->restarts_cnt = 0;
     this->unscheduled_cnt = vector<uint_t> (instance->get_intervention_count() + 1, 0);
+    this->touch();
+}
+
+fitness_t *Solution::get_risk_st(uint_t horizon) {
+    return this->risk_st.data() + this->instance->get_scenario_offset(horizon) + TO_INDEX(horizon);
+}
+
+uint_t *Solution::get_quantile_tail(uint_t horizon) {
+    return this->quantile_tails.data() + this->tail_offsets[horizon];
+}
+
+/* keeps ids ascending, so iteration order and random picks by position do not depend on history */
+static void insert_sorted(uint_vector_t &ids, uint_t id) {
+    ids.insert(lower_bound(ids.begin(), ids.end(), id), id);
+}
+
+static void erase_sorted(uint_vector_t &ids, uint_t id) {
+    ids.erase(lower_bound(ids.begin(), ids.end(), id));
+}
+
+void Solution::touch() {
+    this->version = ++Solution::versions;
 }
 
 void Solution::schedule(uint_t intervention_id, uint_t start_time) {
@@ -58,11 +375,18 @@ void Solution::schedule(uint_t intervention_id, uint_t start_time) {
         cerr << "!! Trying to schedule intervention that is already scheduled " << this->instance->get_intervention(intervention_id) << " !!" << endl;
         exit(SCHEDULE_ERR);
     }
+    bool cached = this->cache_version == this->version;
+    if (this->trailing) this->save_window(intervention_id, 0, start_time);
     this->start_times[intervention_id] = start_time;
-    this->scheduled.insert(intervention_id);
-    this->unscheduled.erase(intervention_id);
+    insert_sorted(this->scheduled, intervention_id);
+    erase_sorted(this->unscheduled, intervention_id);
     this->update_state_on_schedule(intervention_id, start_time);
     this->update_extended_state_on_schedule(intervention_id, start_time);
+    this->touch();
+    if (cached) {
+        this->invalidate_cache(intervention_id, start_time);
+        this->cache_version = this->version;
+    }
 }
 
 void Solution::unschedule(uint_t intervention_id) {
@@ -70,16 +394,144 @@ void Solution::unschedule(uint_t intervention_id) {
         cerr << "!! Trying to unschedule intervention that is not scheduled, id: " << intervention_id << " !!" << endl;
         exit(SCHEDULE_ERR);
     }
-    this->update_state_on_unschedule(intervention_id, this->start_times[intervention_id]);
-    this->update_extended_state_on_unschedule(intervention_id, this->start_times[intervention_id]);
-    this->start_times.erase(intervention_id);
-    this->unscheduled.insert(intervention_id);
-    this->scheduled.erase(intervention_id);
+    bool cached = this->cache_version == this->version;
+    uint_t start_time = this->start_times[intervention_id];
+    if (this->trailing) this->save_window(intervention_id, start_time, 0);
+    this->update_state_on_unschedule(intervention_id, start_time);
+    this->update_extended_state_on_unschedule(intervention_id, start_time);
+    this->start_times[intervention_id] = 0;
+    insert_sorted(this->unscheduled, intervention_id);
+    erase_sorted(this->scheduled, intervention_id);
+    this->touch();
+    if (cached) {
+        this->invalidate_cache(intervention_id, start_time);
+        this->cache_version = this->version;
+    }
 //    this->unscheduled_cnt[intervention_id] ++;
 }
 
+void Solution::checkpoint() {
+    uint_t horizons = this->instance->get_horizon_num();
+    if (this->trailed.size() != horizons + 1) this->trailed.assign(horizons + 1, false);
+    for (uint_t t : this->trailed_horizons) this->trailed[t] = false;
+    this->trail.clear();
+    this->trailed_horizons.clear();
+    this->trail_cells.clear();
+    this->trail_tails.clear();
+    this->trail_underuse = this->resource_underuse;
+    this->trail_overuse = this->resource_overuse;
+    this->trail_unscheduled_cnt = this->unscheduled_cnt;
+    this->trail_objective.mean_risk = this->mean_risk;
+    this->trail_objective.expected_excess = this->expected_excess;
+    this->trail_objective.final_objective = this->final_objective;
+    this->trail_objective.total_resource_use = this->total_resource_use;
+    this->trail_objective.workload_underuse = this->workload_underuse;
+    this->trail_objective.workload_overuse = this->workload_overuse;
+    this->trail_objective.exclusion_penalty = this->exclusion_penalty;
+    this->trail_objective.extended_objective = this->extended_objective;
+    this->trailing = true;
+}
+
+/* (un)scheduling changes state cells only in horizons of its window */
+void Solution::save_window(uint_t intervention, uint_t old_start, uint_t new_start) {
+    uint_t start = old_start ? old_start : new_start;
+    uint_t end = this->instance->get_descriptor(intervention, start).end;
+    uint_t resources = this->instance->get_resources().size();
+    this->trail.push_back({intervention, old_start, new_start});
+    for (uint_t t = start; t < end; ++t) {
+        if (this->trailed[t]) continue;
+        this->trailed[t] = true;
+        this->trailed_horizons.push_back(t);
+        fitness_t *risk_in_t = this->get_risk_st(t);
+        this->trail_cells.insert(this->trail_cells.end(), risk_in_t, risk_in_t + this->instance->get_scenarios(t) + 1);
+        this->trail_cells.push_back(this->mean_cumulative_risks[t]);
+        this->trail_cells.push_back(this->expected_excesses[t]);
+        this->trail_cells.push_back(this->exclusions_at_time[t]);
+        for (uint_t r = 1; r <= resources; ++r) this->trail_cells.push_back(this->resource_use[this->instance->get_ul_index(r, t)]);
+        this->trail_tails.insert(this->trail_tails.end(), this->get_quantile_tail(t), this->get_quantile_tail(t + 1));
+    }
+}
+
+void Solution::rollback() {
+    if (!this->trailing) {
+        cerr << "!! Trying to roll back solution without checkpoint !!" << endl;
+        exit(SCHEDULE_ERR);
+    }
+    bool cached = this->cache_version == this->version;
+    uint_t resources = this->instance->get_resources().size();
+    for (auto record = this->trail.rbegin(); record != this->trail.rend(); ++record) {
+        this->start_times[record->intervention] = record->old_start;
+        if (record->old_start) {
+            insert_sorted(this->scheduled, record->intervention);
+            erase_sorted(this->unscheduled, record->intervention);
+        } else {
+            insert_sorted(this->unscheduled, record->intervention);
+            erase_sorted(this->scheduled, record->intervention);
+        }
+    }
+    const fitness_t *cell = this->trail_cells.data();
+    const uint_t *tail = this->trail_tails.data();
+    for (uint_t t : this->trailed_horizons) {
+        uint_t row = this->instance->get_scenarios(t) + 1;
+        copy(cell, cell + row, this->get_risk_st(t));
+        cell += row;
+        this->mean_cumulative_risks[t] = *cell++;
+        this->expected_excesses[t] = *cell++;
+        this->exclusions_at_time[t] = (uint_t)*cell++;
+        for (uint_t r = 1; r <= resources; ++r) this->resource_use[this->instance->get_ul_index(r, t)] = *cell++;
+        uint_t length = this->tail_offsets[t + 1] - this->tail_offsets[t];
+        copy(tail, tail + length, this->get_quantile_tail(t));
+        tail += length;
+    }
+    this->resource_underuse = this->trail_underuse;
+    this->resource_overuse = this->trail_overuse;
+    this->unscheduled_cnt = this->trail_unscheduled_cnt;
+    this->mean_risk = this->trail_objective.mean_risk;
+    this->expected_excess = this->trail_objective.expected_excess;
+    this->final_objective = this->trail_objective.final_objective;
+    this->total_resource_use = this->trail_objective.total_resource_use;
+    this->workload_underuse = this->trail_objective.workload_underuse;
+    this->workload_overuse = this->trail_objective.workload_overuse;
+    this->exclusion_penalty = this->trail_objective.exclusion_penalty;
+    this->extended_objective = this->trail_objective.extended_objective;
+    this->touch();
+    /* cached estimates stay valid out of windows changed since the checkpoint */
+    if (cached) {
+        for (const trail_record &record : this->trail) {
+            this->invalidate_cache(record.intervention, record.old_start ? record.old_start : record.new_start);
+        }
+        this->cache_version = this->version;
+    }
+    for (uint_t t : this->trailed_horizons) this->trailed[t] = false;
+    this->trail.clear();
+    this->trailed_horizons.clear();
+    this->trail_cells.clear();
+    this->trail_tails.clear();
+}
+
+void Solution::release() {
+    this->trailing = false;
+}
+
+void Solution::follow(const Solution &source) {
+    if (!source.trailing) {
+        cerr << "!! Trying to follow solution without checkpoint !!" << endl;
+        exit(SCHEDULE_ERR);
+    }
+    /* only the final start time of each intervention recorded in the trail matters */
+    for (const trail_record &record : source.trail) {
+        uint_t start_time = source.start_times[record.intervention];
+        if (this->start_times[record.intervention] != start_time && this->is_scheduled(record.intervention)) this->unschedule(record.intervention);
+    }
+    for (const trail_record &record : source.trail) {
+        uint_t start_time = source.start_times[record.intervention];
+        if (start_time && !this->is_scheduled(record.intervention)) this->schedule(record.intervention, start_time);
+    }
+    this->unscheduled_cnt = source.unscheduled_cnt;
+}
+
 bool Solution::is_scheduled(uint_t intervention_id) {
-    return this->scheduled.find(intervention_id) != this->scheduled.end();
+    return this->start_times[intervention_id] != 0;
 }
 
 uint_t Solution::get_start_time(uint_t intervention_id) {
@@ -99,7 +551,7 @@ bool Solution::has_unscheduled() {
 }
 
 uint_t Solution::get_first_unscheduled() {
-    return *(this->unscheduled.begin());
+    return this->unscheduled.front();
 }
 
 void Solution::save(string output_file_path) {
@@ -111,9 +563,9 @@ void Solution::save(string output_file_path) {
     output << "extended_objective: " << extended_objective << endl;
 #endif
 
-    for (uint_to_uint_t::iterator iter = this->start_times.begin(); iter != this->start_times.end(); ++iter) {
-        if (!this->instance->get_intervention(iter->first).empty()) {
-            output << this->instance->get_intervention(iter->first) << " " << iter->second << endl;
+    for (uint_t intervention : this->scheduled) {
+        if (!this->instance->get_intervention(intervention).empty()) {
+            output << this->instance->get_intervention(intervention) << " " << this->start_times[intervention] << endl;
         }
     }
     output.close();
@@ -148,96 +600,594 @@ Objective Solution::estimate_unschedule(uint_t intervention_id) {
     return o;
 }
 
+/* sum of changes of one objective part over horizons start <= t < end, sums hold CHANGES prefix sum arrays */
+static fitness_t window_sum(const fitness_t *sums, uint_t horizons, uint_t part, uint_t start, uint_t end) {
+    const fitness_t *sum = sums + part * (horizons + 1);
+    return sum[TO_INDEX(end)] - sum[TO_INDEX(start)];
+}
+
+/* turns CHANGES arrays of changes in horizons into prefix sums */
+static void prefix_sums(fitness_t *sums, uint_t horizons) {
+    for (fitness_t *sum = sums; sum < sums + CHANGES * (horizons + 1); sum += horizons + 1) {
+        for (uint_t t = 1; t <= horizons; ++t) sum[t] += sum[TO_INDEX(t)];
+    }
+}
+
+/*
+ * estimates scheduling of the intervention at each start time, objectives[t] holds estimate for start time t
+ * shift invariant workloads and risks are evaluated once per horizon and summed over windows of start times,
+ * other ones are estimated for each start time separately
+ */
+void Solution::estimate_schedule_times(uint_t intervention_id, vector<Objective> &objectives) {
+    if (this->is_scheduled(intervention_id)) {
+        cerr << "!! Trying to estimate schedule of intervention that is already scheduled " << this->instance->get_intervention(intervention_id) << " !!" << endl;
+        exit(SCHEDULE_ERR);
+    }
+    uint_t t_max = this->instance->get_t_max(intervention_id);
+    uint_t horizons = this->instance->get_horizon_num();
+    bool risk_invariant = this->instance->has_shift_invariant_risk(intervention_id);
+    bool workload_invariant = this->instance->has_shift_invariant_workload(intervention_id);
+    fitness_t *added = horizon_buffer(CHANGES * (horizons + 1));
+    uint_t end;
+    objectives.resize(t_max + 1);
+    this->sum_horizon_changes(intervention_id, risk_invariant, workload_invariant, 0, 0, added);
+    for (uint_t t = 1; t <= t_max; ++t) {
+        Objective &o = objectives[t];
+        end = min(this->instance->get_descriptor(intervention_id, t).end, horizons + 1);
+        if (risk_invariant) {
+            o.mean_risk = this->mean_risk + window_sum(added, horizons, CHANGE_MEAN_RISK, t, end);
+            o.expected_excess = this->expected_excess + window_sum(added, horizons, CHANGE_EXPECTED_EXCESS, t, end);
+            o.final_objective = this->instance->get_alpha() * o.mean_risk + (1 - this->instance->get_alpha()) * o.expected_excess;
+        } else {
+            this->estimate_state_on_schedule(intervention_id, t, &o);
+        }
+        if (workload_invariant) {
+            o.workload_underuse = std::max(this->workload_underuse - window_sum(added, horizons, CHANGE_UNDERUSE, t, end), 0.0);
+            o.workload_overuse = this->workload_overuse + window_sum(added, horizons, CHANGE_OVERUSE, t, end);
+            o.total_resource_use = this->total_resource_use + window_sum(added, horizons, CHANGE_RESOURCE_USE, t, end);
+            o.exclusion_penalty = this->exclusion_penalty + (uint_t)window_sum(added, horizons, CHANGE_EXCLUSIONS, t, end);
+            o.extended_objective = o.final_objective + BETA_LOWER * o.workload_underuse + BETA_UPPER  * o.workload_overuse + GAMMA * o.exclusion_penalty;
+        } else {
+            this->estimate_extended_state_on_schedule(intervention_id, t, &o);
+        }
+    }
+}
+
+/*
+ * change caused by scheduling at a start time depends only on the state in its window and on exclusion partners overlapping it,
+ * so the cached changes stay valid until a window overlapping theirs is (un)scheduled, objectives are rebuilt from current state
+ */
+void Solution::estimate_schedule_times_cached(uint_t intervention_id, vector<Objective> &objectives) {
+    if (this->is_scheduled(intervention_id)) {
+        cerr << "!! Trying to estimate schedule of intervention that is already scheduled " << this->instance->get_intervention(intervention_id) << " !!" << endl;
+        exit(SCHEDULE_ERR);
+    }
+    uint_t t_max = this->instance->get_t_max(intervention_id);
+    uint_t invalid = 0;
+    this->prepare_cache();
+    vector<fitness_t> &cache = this->schedule_cache[intervention_id];
+    if (cache.empty()) {
+        cache.resize((t_max + 1) * CACHE_ITEM, 0.0);
+        #pragma omp critical(schedule_cache)
+        this->cached_interventions.push_back(intervention_id);
+        invalid = t_max;
+    } else {
+        for (uint_t t = 1; t <= t_max; ++t) invalid += cache[t * CACHE_ITEM + CACHE_VALID] == 0.0;
+    }
+    /* windows evaluated one by one are cheaper only while few start times are invalid */
+    if (2 * invalid > t_max) {
+        this->estimate_schedule_times(intervention_id, objectives);
+        for (uint_t t = 1; t <= t_max; ++t) this->cache_changes(objectives[t], cache.data() + t * CACHE_ITEM);
+    } else if (invalid > 0) {
+        for (uint_t t = 1; t <= t_max; ++t) {
+            if (cache[t * CACHE_ITEM + CACHE_VALID] != 0.0) continue;
+            Objective o;
+            this->estimate_state_on_schedule(intervention_id, t, &o);
+            this->estimate_extended_state_on_schedule(intervention_id, t, &o);
+            this->cache_changes(o, cache.data() + t * CACHE_ITEM);
+        }
+    }
+    objectives.resize(t_max + 1);
+    for (uint_t t = 1; t <= t_max; ++t) this->fill_objective(cache.data() + t * CACHE_ITEM, &objectives[t]);
+}
+
+/* state was changed otherwise than by (un)scheduling or the cache was never used */
+void Solution::prepare_cache() {
+    if (this->cache_version == this->version) return;
+    for (uint_t intervention : this->cached_interventions) this->schedule_cache[intervention].clear();
+    this->cached_interventions.clear();
+    this->schedule_cache.resize(this->instance->get_intervention_count() + 1);
+    this->cache_version = this->version;
+}
+
+/* changes are stored in the same form as fill_objective expects them */
+void Solution::cache_changes(const Objective &objective, fitness_t *item) {
+    item[CHANGE_MEAN_RISK] = objective.mean_risk - this->mean_risk;
+    item[CHANGE_EXPECTED_EXCESS] = objective.expected_excess - this->expected_excess;
+    item[CHANGE_UNDERUSE] = this->workload_underuse - objective.workload_underuse;
+    item[CHANGE_OVERUSE] = objective.workload_overuse - this->workload_overuse;
+    item[CHANGE_RESOURCE_USE] = objective.total_resource_use - this->total_resource_use;
+    item[CHANGE_EXCLUSIONS] = (fitness_t)objective.exclusion_penalty - (fitness_t)this->exclusion_penalty;
+    item[CACHE_VALID] = 1.0;
+}
+
+/*
+ * intervention (un)scheduled at start time changes only horizons of its window, overlap of windows also covers exclusion partners
+ * as exclusions are counted only in horizons covered by both windows, cache of the intervention itself is dropped
+ */
+void Solution::invalidate_cache(uint_t intervention, uint_t start_time) {
+    if (this->schedule_cache.empty()) return;
+    uint_t end = this->instance->get_descriptor(intervention, start_time).end;
+    if (!this->schedule_cache[intervention].empty()) {
+        this->schedule_cache[intervention].clear();
+        this->cached_interventions.erase(find(this->cached_interventions.begin(), this->cached_interventions.end(), intervention));
+    }
+    for (uint_t cached : this->cached_interventions) {
+        fitness_t *cache = this->schedule_cache[cached].data();
+        for (uint_t t = 1; t < end && t <= this->instance->get_t_max(cached); ++t) {
+            if (this->instance->get_descriptor(cached, t).end > start_time) cache[t * CACHE_ITEM + CACHE_VALID] = 0.0;
+        }
+    }
+}
+
+/*
+ * estimates moving of scheduled intervention to each start time, objectives[t] holds estimate for start time t
+ * horizons the intervention leaves are summed from changes of unscheduling it, horizons it enters are handled
+ * as in estimate_schedule_times, state of the solution stays untouched
+ */
+void Solution::estimate_move_times(uint_t intervention_id, vector<Objective> &objectives) {
+    if (!this->is_scheduled(intervention_id)) {
+        cerr << "!! Trying to estimate move of intervention that is not scheduled " << this->instance->get_intervention(intervention_id) << " !!" << endl;
+        exit(SCHEDULE_ERR);
+    }
+    uint_t t_max = this->instance->get_t_max(intervention_id);
+    uint_t horizons = this->instance->get_horizon_num();
+    uint_t current = this->start_times[intervention_id];
+    uint_t current_end = min(this->instance->get_descriptor(intervention_id, current).end, horizons + 1);
+    uint_t unscheduled = 0;
+    bool risk_invariant = this->instance->has_shift_invariant_risk(intervention_id);
+    bool workload_invariant = this->instance->has_shift_invariant_workload(intervention_id);
+    fitness_t *added = horizon_buffer(2 * CHANGES * (horizons + 1));
+    fitness_t *removed = added + CHANGES * (horizons + 1);
+    fitness_t *exclusions = removed + CHANGE_EXCLUSIONS * (horizons + 1);
+    fitness_t change[CHANGES];
+    fitness_t moved[CHANGES];
+    uint_t end;
+    objectives.resize(t_max + 1);
+    /* changes of horizons the intervention does not occupy now, only shift invariant parts are summed */
+    this->sum_horizon_changes(intervention_id, risk_invariant, workload_invariant, current, current_end, added);
+    /* changes of horizons the intervention occupies now if it is unscheduled */
+    fill(removed, removed + CHANGES * (horizons + 1), 0.0);
+    this->count_exclusions(intervention_id, exclusions, 0);
+    for (uint_t t = 1; t <= horizons; ++t) {
+        exclusions[t] = t >= current && t < current_end ? -exclusions[t] : 0.0;
+    }
+    for (uint_t t = current; t < current_end; ++t) {
+        this->horizon_change(t, &intervention_id, &current, &unscheduled, 1, true, true, change);
+        for (uint_t part = 0; part < CHANGE_EXCLUSIONS; ++part) removed[part * (horizons + 1) + t] = change[part];
+    }
+    prefix_sums(removed, horizons);
+    for (uint_t t = 1; t <= t_max; ++t) {
+        Objective &o = objectives[t];
+        end = min(this->instance->get_descriptor(intervention_id, t).end, horizons + 1);
+        for (uint_t part = 0; part < CHANGES; ++part) {
+            moved[part] = window_sum(removed, horizons, part, 1, current_end) - window_sum(removed, horizons, part, t, end) + window_sum(added, horizons, part, t, end);
+        }
+        /* parts that depend on start time are evaluated in the new window, removal included where windows overlap */
+        if (!risk_invariant || !workload_invariant) {
+            for (uint_t h = t; h < end; ++h) {
+                this->horizon_change(h, &intervention_id, &current, &t, 1, !risk_invariant, !workload_invariant, change);
+                for (uint_t part = 0; part < CHANGE_EXCLUSIONS; ++part) moved[part] += change[part];
+            }
+        }
+        this->fill_objective(moved, &o);
+    }
+}
+
+/* estimates moving of scheduled intervention to start time, state of the solution stays untouched */
+Objective Solution::estimate_move(uint_t intervention_id, uint_t start_time) {
+    if (!this->is_scheduled(intervention_id)) {
+        cerr << "!! Trying to estimate move of intervention that is not scheduled " << this->instance->get_intervention(intervention_id) << " !!" << endl;
+        exit(SCHEDULE_ERR);
+    }
+    uint_t current = this->start_times[intervention_id];
+    return this->estimate_moves(&intervention_id, &current, &start_time, 1);
+}
+
+/*
+ * estimates unscheduling of interventions from old start times and scheduling them to new start times (0 = stays unscheduled),
+ * rows and exclusions are removed and added in the same order as sequence of unschedule and schedule calls would do
+ */
+Objective Solution::estimate_moves(const uint_t *interventions, const uint_t *old_starts, const uint_t *new_starts, uint_t count) {
+    uint_t horizons = this->instance->get_horizon_num();
+    uint_t first = horizons + 1;
+    uint_t last = 0;
+    uint_t start;
+    uint_t end;
+    uint_t start2;
+    uint_t end2;
+    uint_t intervention;
+    uint_t e;
+    uint_t overlap;
+    bool covered;
+    fitness_t change[CHANGES];
+    fitness_t moved[CHANGES] = {};
+    int exclusions = 0;
+    Objective o;
+    for (uint_t k = 0; k < 2 * count; ++k) {
+        start = k < count ? old_starts[k] : new_starts[k - count];
+        if (start == 0) continue;
+        first = std::min(first, start);
+        last = std::max(last, this->instance->get_descriptor(interventions[k % count], start).end);
+    }
+    for (uint_t t = first; t < last && t <= horizons; ++t) {
+        covered = false;
+        for (uint_t k = 0; k < count && !covered; ++k) {
+            covered = (old_starts[k] && this->instance->in_window(interventions[k], old_starts[k], t)) ||
+                      (new_starts[k] && this->instance->in_window(interventions[k], new_starts[k], t));
+        }
+        if (!covered) continue;
+        this->horizon_change(t, interventions, old_starts, new_starts, count, true, true, change);
+        for (uint_t part = 0; part < CHANGE_EXCLUSIONS; ++part) moved[part] += change[part];
+    }
+    for (uint_t k = 0; k < 2 * count; ++k) {
+        intervention = interventions[k % count];
+        start = k < count ? old_starts[k] : new_starts[k - count];
+        if (start == 0) continue;
+        end = this->instance->get_descriptor(intervention, start).end;
+        for (uint_t item = this->instance->get_exclusion_begin(intervention); item < this->instance->get_exclusion_end(intervention); ++item) {
+            e = this->instance->get_exclusion_partner(item);
+            /* moved interventions are unscheduled one after another and then scheduled again */
+            start2 = this->start_times[e];
+            for (uint_t j = 0; j < count; ++j) {
+                if (interventions[j] != e) continue;
+                if (k < count) start2 = j < k ? 0 : old_starts[j];
+                else start2 = j < k - count ? new_starts[j] : 0;
+            }
+            if (start2 == 0) continue;
+            end2 = this->instance->get_descriptor(e, start2).end;
+            overlap = this->instance->count_season_overlap(this->instance->get_exclusion_season_id(item), start, end, start2, end2);
+            exclusions += k < count ? -(int)overlap : (int)overlap;
+        }
+    }
+    moved[CHANGE_EXCLUSIONS] = exclusions;
+    this->fill_objective(moved, &o);
+    return o;
+}
+
+/*
+ * estimates moving scheduled intervention i1 to start time t1 and scheduled intervention i2 to each start time,
+ * objectives[t2] holds estimate for start time t2 and objectives[0] estimate with i2 left unscheduled,
+ * horizons touched by rows of i1 or current row of i2 are corrected for both interventions,
+ * the rest is handled as in estimate_schedule_times, state of the solution stays untouched
+ */
+void Solution::estimate_two_move_times(uint_t i1, uint_t t1, uint_t i2, vector<Objective> &objectives) {
+    if (!this->is_scheduled(i1) || !this->is_scheduled(i2)) {
+        cerr << "!! Trying to estimate move of intervention that is not scheduled " << this->instance->get_intervention(this->is_scheduled(i1) ? i2 : i1) << " !!" << endl;
+        exit(SCHEDULE_ERR);
+    }
+    uint_t t_max = this->instance->get_t_max(i2);
+    uint_t horizons = this->instance->get_horizon_num();
+    uint_t interventions[2] = {i1, i2};
+    uint_t old_starts[2] = {this->start_times[i1], this->start_times[i2]};
+    uint_t new_starts[2] = {t1, 0};
+    uint_t unscheduled = 0;
+    bool risk_invariant = this->instance->has_shift_invariant_risk(i2);
+    bool workload_invariant = this->instance->has_shift_invariant_workload(i2);
+    /* changes caused by i2 depend only on the state, so they are kept while the same pair is evaluated for more t1 */
+    static thread_local vector<fitness_t> added_cache;
+    static thread_local ullint_t cached_version = 0;
+    static thread_local uint_t cached_intervention = 0;
+    fitness_t *corrections = horizon_buffer(2 * CHANGES * (horizons + 1));
+    fitness_t *without = corrections + CHANGES * (horizons + 1); /* changes in touched horizons while i2 is unscheduled */
+    fitness_t *exclusions = corrections + CHANGE_EXCLUSIONS * (horizons + 1);
+    fitness_t *exclusions1 = without + CHANGE_EXCLUSIONS * (horizons + 1);
+    fitness_t change[CHANGES];
+    fitness_t fixed[CHANGES] = {};
+    fitness_t moved[CHANGES];
+    fitness_t excluded = 0;
+    uint_t duration;
+    uint_t end;
+    uint_t next = 1;
+    auto touched = [&](uint_t t) {
+        return this->instance->in_window(i1, old_starts[0], t) || this->instance->in_window(i2, old_starts[1], t) || this->instance->in_window(i1, t1, t);
+    };
+    auto invariant = [&](uint_t part) { return part < CHANGE_UNDERUSE ? risk_invariant : workload_invariant; };
+    objectives.resize(t_max + 1);
+    if (cached_version != this->version || cached_intervention != i2 || added_cache.size() < CHANGES * (horizons + 1)) {
+        added_cache.resize(CHANGES * (horizons + 1));
+        this->sum_horizon_changes(i2, risk_invariant, workload_invariant, 0, 0, added_cache.data());
+        cached_version = this->version;
+        cached_intervention = i2;
+    }
+    const fitness_t *added = added_cache.data();
+    fill(corrections, corrections + 2 * CHANGES * (horizons + 1), 0.0);
+    for (uint_t t = 1; t <= horizons; ++t) {
+        if (!touched(t)) continue;
+        this->horizon_change(t, interventions, old_starts, new_starts, 2, true, true, change);
+        for (uint_t part = 0; part < CHANGE_EXCLUSIONS; ++part) {
+            without[part * (horizons + 1) + t] = change[part];
+            fixed[part] += change[part];
+        }
+    }
+    /* shift invariant row of i2 is added to touched horizons, covered by the first start time as in sum_horizon_changes */
+    if (risk_invariant || workload_invariant) {
+        for (uint_t start = 1; start <= t_max; ++start) {
+            duration = this->instance->get_descriptor(i2, start).duration;
+            new_starts[1] = start;
+            for (uint_t t = std::max(next, start); t < start + duration && t <= horizons; ++t) {
+                if (!touched(t)) continue;
+                this->horizon_change(t, interventions, old_starts, new_starts, 2, risk_invariant, workload_invariant, change);
+                for (uint_t part = 0; part < CHANGE_EXCLUSIONS; ++part) {
+                    if (!invariant(part)) continue;
+                    corrections[part * (horizons + 1) + t] = change[part] - without[part * (horizons + 1) + t] - window_sum(added, horizons, part, t, t + 1);
+                }
+            }
+            next = std::max(next, start + duration);
+        }
+        new_starts[1] = 0;
+    }
+    /* exclusions with other interventions are counted separately from exclusions between i1 and i2 */
+    this->count_exclusions(i1, exclusions1, i2);
+    this->count_exclusions(i2, exclusions, i1);
+    for (uint_t t = 1; t <= horizons; ++t) {
+        if (this->instance->in_window(i1, t1, t)) excluded += exclusions1[t];
+        if (this->instance->in_window(i1, old_starts[0], t)) excluded -= exclusions1[t];
+        if (this->instance->in_window(i2, old_starts[1], t)) excluded -= exclusions[t];
+    }
+    for (uint_t item = this->instance->get_exclusion_begin(i1); item < this->instance->get_exclusion_end(i1); ++item) {
+        if (this->instance->get_exclusion_partner(item) != i2) continue;
+        for (uint_t t : this->instance->get_season(this->instance->get_exclusion_season_id(item))) {
+            if (this->instance->in_window(i1, old_starts[0], t) && this->instance->in_window(i2, old_starts[1], t)) excluded--;
+            if (this->instance->in_window(i1, t1, t)) exclusions[t]++;
+        }
+    }
+    fixed[CHANGE_EXCLUSIONS] = excluded;
+    prefix_sums(corrections, horizons);
+    this->fill_objective(fixed, &objectives[0]);
+    for (uint_t t2 = 1; t2 <= t_max; ++t2) {
+        end = min(this->instance->get_descriptor(i2, t2).end, horizons + 1);
+        for (uint_t part = 0; part < CHANGES; ++part) {
+            moved[part] = fixed[part] + window_sum(corrections, horizons, part, t2, end);
+            if (invariant(part) && part < CHANGE_EXCLUSIONS) moved[part] += window_sum(added, horizons, part, t2, end);
+        }
+        /* parts that depend on start time are evaluated in the new window of i2 */
+        if (!risk_invariant || !workload_invariant) {
+            new_starts[1] = t2;
+            for (uint_t t = t2; t < end; ++t) {
+                if (touched(t)) {
+                    this->horizon_change(t, interventions, old_starts, new_starts, 2, !risk_invariant, !workload_invariant, change);
+                } else {
+                    this->horizon_change(t, &i2, &unscheduled, &t2, 1, !risk_invariant, !workload_invariant, change);
+                }
+                for (uint_t part = 0; part < CHANGE_EXCLUSIONS; ++part) {
+                    if (invariant(part)) continue;
+                    moved[part] += change[part] - (touched(t) ? without[part * (horizons + 1) + t] : 0.0);
+                }
+            }
+            new_starts[1] = 0;
+        }
+        this->fill_objective(moved, &objectives[t2]);
+    }
+}
+
+/* objective of the solution changed by changes of all objective parts */
+void Solution::fill_objective(const fitness_t *changes, Objective *objective) {
+    objective->mean_risk = this->mean_risk + changes[CHANGE_MEAN_RISK];
+    objective->expected_excess = this->expected_excess + changes[CHANGE_EXPECTED_EXCESS];
+    objective->final_objective = this->instance->get_alpha() * objective->mean_risk + (1 - this->instance->get_alpha()) * objective->expected_excess;
+    objective->workload_underuse = std::max(this->workload_underuse - changes[CHANGE_UNDERUSE], 0.0);
+    objective->workload_overuse = std::max(this->workload_overuse + changes[CHANGE_OVERUSE], 0.0);
+    objective->total_resource_use = this->total_resource_use + changes[CHANGE_RESOURCE_USE];
+    objective->exclusion_penalty = (uint_t)((int)this->exclusion_penalty + (int)changes[CHANGE_EXCLUSIONS]);
+    objective->extended_objective = objective->final_objective + BETA_LOWER * objective->workload_underuse + BETA_UPPER  * objective->workload_overuse + GAMMA * objective->exclusion_penalty;
+}
+
+/*
+ * fills CHANGES prefix sum arrays (horizon_num + 1 items each) with changes that scheduling the intervention causes in each horizon,
+ * horizon is evaluated with the first start time whose window covers it, so only shift invariant parts are valid,
+ * horizons skip_start <= t < skip_end are left out
+ */
+void Solution::sum_horizon_changes(uint_t intervention, bool risk, bool workload, uint_t skip_start, uint_t skip_end, fitness_t *sums) {
+    uint_t horizons = this->instance->get_horizon_num();
+    uint_t duration;
+    uint_t next = 1;
+    uint_t unscheduled = 0;
+    fitness_t change[CHANGES];
+    fitness_t *exclusions = sums + CHANGE_EXCLUSIONS * (horizons + 1);
+    fill(sums, sums + CHANGES * (horizons + 1), 0.0);
+    if (risk || workload) {
+        for (uint_t start = 1; start <= this->instance->get_t_max(intervention); ++start) {
+            duration = this->instance->get_descriptor(intervention, start).duration;
+            for (uint_t t = std::max(next, start); t < start + duration && t <= horizons; ++t) {
+                if (t >= skip_start && t < skip_end) continue;
+                this->horizon_change(t, &intervention, &unscheduled, &start, 1, risk, workload, change);
+                for (uint_t part = 0; part < CHANGE_EXCLUSIONS; ++part) sums[part * (horizons + 1) + t] = change[part];
+            }
+            next = std::max(next, start + duration);
+        }
+    }
+    this->count_exclusions(intervention, exclusions, 0);
+    for (uint_t t = skip_start; t < skip_end; ++t) exclusions[t] = 0;
+    prefix_sums(sums, horizons);
+}
+
+/* adds number of scheduled interventions (except ignored one) in exclusion with the intervention to each horizon where the exclusion applies */
+void Solution::count_exclusions(uint_t intervention, fitness_t *counts, uint_t ignored) {
+    uint_t start2;
+    uint_t end2;
+    uint_t e;
+    for (uint_t item = this->instance->get_exclusion_begin(intervention); item < this->instance->get_exclusion_end(intervention); ++item) {
+        e = this->instance->get_exclusion_partner(item);
+        if (e != ignored && this->is_scheduled(e)) {
+            start2 = this->start_times[e];
+            end2 = this->instance->get_descriptor(e, start2).end;
+            for (uint_t t : this->instance->get_season(this->instance->get_exclusion_season_id(item))) {
+                if (t >= start2 && t < end2) counts[t]++;
+            }
+        }
+    }
+}
+
+/*
+ * changes of objective parts (except exclusions) in horizon after rows of interventions in old start times are removed
+ * and rows in new start times are added (0 = no row), in the same order as unschedule and schedule calls would do
+ */
+void Solution::horizon_change(uint_t horizon, const uint_t *interventions, const uint_t *old_starts, const uint_t *new_starts, uint_t count, bool risk, bool workload, fitness_t *change) {
+    static thread_local vector<pair<uint_t, fitness_t>> uses; /* resource use in horizon changed by previous rows */
+    uint_t horizons = this->instance->get_horizon_num();
+    uint_t scenarios;
+    uint_t Qtt_index;
+    uint_t intervention;
+    uint_t start;
+    uint_t position;
+    uint_t r;
+    ullint_t ul_idx;
+    uint_t cell;
+    bool removal;
+    fitness_t risk_t_;
+    fitness_t mean_cumulative_risk;
+    fitness_t Qtt;
+    fitness_t before;
+    fitness_t after;
+    fitness_t value;
+    fitness_t max;
+    fitness_t min;
+    fitness_t *arr;
+    const fitness_t *risk_in_t;
+    const half_fitness_t *risk_in_s;
+    const half_fitness_t *r_in_t;
+    const uint_t *resources;
+    fill(change, change + CHANGE_EXCLUSIONS, 0.0);
+    if (risk) {
+        scenarios = this->instance->get_scenarios(horizon);
+        Qtt_index = this->instance->get_quantile_index(horizon);
+        arr = scenario_buffer(2 * (scenarios + 1));
+        risk_in_t = this->get_risk_st(horizon);
+        copy(risk_in_t, risk_in_t + scenarios + 1, arr);
+        mean_cumulative_risk = this->mean_cumulative_risks[horizon];
+        for (uint_t k = 0; k < 2 * count; ++k) {
+            intervention = interventions[k % count];
+            start = k < count ? old_starts[k] : new_starts[k - count];
+            if (start == 0 || horizon < start) continue;
+            const start_descriptor &descriptor = this->instance->get_descriptor(intervention, start);
+            if (horizon >= descriptor.end) continue;
+            risk_in_s = this->instance->risk.data() + descriptor.risk_row + (this->instance->get_scenario_offset(horizon) - this->instance->get_scenario_offset(start));
+            if (k < count) {
+                for (uint_t s = 1; s <= scenarios; ++s) arr[s] -= risk_in_s[TO_INDEX(s)];
+            } else {
+                for (uint_t s = 1; s <= scenarios; ++s) arr[s] += risk_in_s[TO_INDEX(s)];
+            }
+            risk_t_ = this->instance->get_period_mean_risks(descriptor)[horizon - start];
+            if (k < count) risk_t_ = -risk_t_;
+            mean_cumulative_risk += risk_t_;
+            change[CHANGE_MEAN_RISK] += risk_t_ / horizons;
+        }
+        Qtt = select_row[this->instance->get_scenario_kernel(horizon)](arr, scenarios + 1, Qtt_index, this->get_quantile_tail(horizon), arr + scenarios + 1) - mean_cumulative_risk;
+        change[CHANGE_EXPECTED_EXCESS] = ((Qtt > 0 ? Qtt : 0) - this->expected_excesses[horizon]) / horizons;
+    }
+    if (workload) {
+        uses.clear();
+        for (uint_t k = 0; k < 2 * count; ++k) {
+            intervention = interventions[k % count];
+            start = k < count ? old_starts[k] : new_starts[k - count];
+            if (start == 0 || horizon < start) continue;
+            const start_descriptor &descriptor = this->instance->get_descriptor(intervention, start);
+            if (horizon >= descriptor.end) continue;
+            removal = k < count;
+            resources = this->instance->get_descriptor_resources(descriptor);
+            r_in_t = this->instance->r.data() + descriptor.r_window + (horizon - start);
+            for (position = 0; position < descriptor.resource_count; ++position) {
+                r = resources[position];
+                value = r_in_t[position * descriptor.duration];
+                for (cell = 0; cell < uses.size() && uses[cell].first != r; ++cell);
+                ul_idx = this->instance->get_ul_index(r, horizon);
+                if (cell == uses.size()) uses.emplace_back(r, this->resource_use[ul_idx]);
+                before = uses[cell].second;
+                max = this->instance->u[ul_idx];
+                min = this->instance->l[ul_idx];
+                if (removal) {
+                    after = before - value;
+                    if (after < min - NUMERIC_TOLERANCE) {
+                        change[CHANGE_UNDERUSE] -= before < min ? value : min - after;
+                    }
+                    if (before > max) {
+                        change[CHANGE_OVERUSE] -= after > max + NUMERIC_TOLERANCE ? value : before - max;
+                    }
+                    change[CHANGE_RESOURCE_USE] -= value;
+                } else {
+                    after = before + value;
+                    if (before < min) {
+                        change[CHANGE_UNDERUSE] += after < min - NUMERIC_TOLERANCE ? value : min - before;
+                    }
+                    if (after > max + NUMERIC_TOLERANCE) {
+                        change[CHANGE_OVERUSE] += before > max ? value : after - max;
+                    }
+                    change[CHANGE_RESOURCE_USE] += value;
+                }
+                uses[cell].second = after;
+            }
+        }
+    }
+}
+
 void Solution::update_state_on_schedule(uint_t scheduled_intervention, uint_t start_time) {
+    const start_descriptor &descriptor = this->instance->get_descriptor(scheduled_intervention, start_time);
     uint_t scenarios;
     uint_t horizons = this->instance->get_horizon_num();
-    fitness_t risk_st;
-    fitness_t risk_t_;
     fitness_t Q_tt;
     fitness_t excess;
     uint_t Qtt_index;
-    array<fitness_t, ARR_SIZE> arr;
-    vector<fitness_t> vec;
-    uint_t risk_in_s_idx = this->instance->get_risk_index(scheduled_intervention, start_time, start_time);
-    half_fitness_vector_t risk_in_s;
-    for (uint_t t = start_time; t < start_time + this->instance->delta[this->instance->get_delta_index(scheduled_intervention, start_time)]; ++t) {
+    fitness_t *risk_in_t;
+    /* risk rows of the window are stored one after another, their means do not depend on the solution */
+    const half_fitness_t *risk_in_s = this->instance->risk.data() + descriptor.risk_row;
+    const fitness_t *means = this->instance->get_period_mean_risks(descriptor);
+    this->mean_risk += descriptor.mean_risk;
+    for (uint_t t = start_time; t < descriptor.end; ++t) {
         scenarios = this->instance->get_scenarios(t);
-        risk_in_s = this->instance->risk[risk_in_s_idx++];
-        for (uint_t s = 1; s <= scenarios; ++s) {
-            risk_st = risk_in_s[TO_INDEX(s)];
-            risk_t_ = (risk_st / scenarios);
-            this->risk_st[t][s] += risk_st;
-            this->mean_cumulative_risks[t] += risk_t_;
-            this->mean_risk += (risk_t_ / horizons);
-        }
-        Qtt_index = ceil(scenarios * this->instance->get_quantile());
-        if (scenarios < ARR_SIZE) {
-            copy(this->risk_st[t].begin(), this->risk_st[t].end(), arr.begin());
-            nth_element(arr.begin(), arr.begin() + Qtt_index, ARR_END_IT(arr.begin(), scenarios));
-            Q_tt = arr[Qtt_index] - this->mean_cumulative_risks[t];
-        } else {
-            vec = this->risk_st[t];
-            nth_element(vec.begin(), vec.begin() + Qtt_index, vec.end());
-            Q_tt = vec[Qtt_index] - this->mean_cumulative_risks[t];
-        }
+        risk_in_t = this->get_risk_st(t);
+        for (uint_t s = 1; s <= scenarios; ++s) risk_in_t[s] += risk_in_s[TO_INDEX(s)];
+        this->mean_cumulative_risks[t] += means[t - start_time];
+        Qtt_index = this->instance->get_quantile_index(t);
+        Q_tt = track_quantile(risk_in_t, scenarios + 1, Qtt_index, this->get_quantile_tail(t)) - this->mean_cumulative_risks[t];
         excess = Q_tt < 0 ? 0 : Q_tt;
         this->expected_excess += ((excess - this->expected_excesses[t]) / horizons);
         this->expected_excesses[t] = excess;
+        risk_in_s += scenarios;
     }
     this->final_objective = this->instance->get_alpha() * this->mean_risk + (1 - this->instance->get_alpha()) * this->expected_excess;
 }
 
 void Solution::update_extended_state_on_schedule(uint scheduled_intervention, uint_t start_time) {
-    fitness_t before;
-    fitness_t after;
-    fitness_t gain;
-    fitness_t max;
-    fitness_t min;
-    uint_t end = start_time + this->instance->delta[this->instance->get_delta_index(scheduled_intervention, start_time)];
-    uint_t r_idx;
-    uint_t ul_idx;
-    for (uint_t r : this->instance->get_interventions_resources(scheduled_intervention)) {
-        r_idx = this->instance->get_r_index(scheduled_intervention, start_time, r, start_time);
+    const start_descriptor &descriptor = this->instance->get_descriptor(scheduled_intervention, start_time);
+    const uint_t *resources = this->instance->get_descriptor_resources(descriptor);
+    uint_t r;
+    fitness_t sums[WINDOW_SUMS];
+    uint_t end = descriptor.end;
+    ullint_t ul_idx;
+    /* workload windows of used resources are stored one after another */
+    const half_fitness_t *r_in_t = this->instance->r.data() + descriptor.r_window;
+    for (uint_t position = 0; position < descriptor.resource_count; ++position) {
+        r = resources[position];
         ul_idx = this->instance->get_ul_index(r, start_time);
-        for (uint_t t = start_time; t < end; ++t) {
-            before = this->resource_use[r][t];
-            gain = this->instance->r[r_idx++];
-            after = before + gain;
-            max = this->instance->u[ul_idx];
-            min = this->instance->l[ul_idx++];
-            if (before < min) {
-                if (after < min - NUMERIC_TOLERANCE) {
-                    this->resource_underuse[r] -= gain;
-                    this->resource_underuse[r] = std::max(this->resource_underuse[r], 0.0);
-                    this->workload_underuse -= gain;
-                    this->workload_underuse = std::max(this->workload_underuse, 0.0);
-                } else {
-                    this->resource_underuse[r] -= (min - before);
-                    this->resource_underuse[r] = std::max(this->resource_underuse[r], 0.0);
-                    this->workload_underuse -= (min - before);
-                    this->workload_underuse = std::max(this->workload_underuse, 0.0);
-                }
-            }
-            if (after > max + NUMERIC_TOLERANCE) {
-                if (before > max) {
-                    this->resource_overuse[r] += gain;
-                    this->workload_overuse += gain;
-                } else {
-                    this->resource_overuse[r] += (after - max);
-                    this->workload_overuse += (after - max);
-                }
-            }
-            this->resource_use[r][t] = after;
-            this->total_resource_use += gain;
-        }
+        fill(sums, sums + WINDOW_SUMS, 0.0);
+        add_window(this->resource_use.data() + ul_idx, r_in_t, this->instance->u + ul_idx, this->instance->l + ul_idx, end - start_time, sums, this->resource_use.data() + ul_idx);
+        r_in_t += end - start_time;
+        this->resource_underuse[r] = std::max(this->resource_underuse[r] - sums[WINDOW_UNDERUSE], 0.0);
+        this->workload_underuse = std::max(this->workload_underuse - sums[WINDOW_UNDERUSE], 0.0);
+        this->resource_overuse[r] += sums[WINDOW_OVERUSE];
+        this->workload_overuse += sums[WINDOW_OVERUSE];
+        this->total_resource_use += sums[WINDOW_TOTAL];
     }
     uint_t start2;
     uint_t end2;
-    for (uint_t e : this->instance->get_excluded(scheduled_intervention)) {
+    uint_t e;
+    for (uint_t item = this->instance->get_exclusion_begin(scheduled_intervention); item < this->instance->get_exclusion_end(scheduled_intervention); ++item) {
+        e = this->instance->get_exclusion_partner(item);
         if (this->is_scheduled(e)) {
             start2 = this->start_times[e];
-            end2 = start2 + this->instance->delta[this->instance->get_delta_index(e, start2)];
-            for (uint_t t : this->instance->get_exclusion_season(scheduled_intervention, e)) {
+            end2 = this->instance->get_descriptor(e, start2).end;
+            for (uint_t t : this->instance->get_season(this->instance->get_exclusion_season_id(item))) {
                 if (
                     t >= start_time && t >= start2 &&
                     t < end && t < end2
@@ -252,95 +1202,62 @@ void Solution::update_extended_state_on_schedule(uint scheduled_intervention, ui
 }
 
 void Solution::update_state_on_unschedule(uint_t unscheduled_intervention, uint_t start_time) {
+    const start_descriptor &descriptor = this->instance->get_descriptor(unscheduled_intervention, start_time);
     uint_t scenarios;
     uint_t horizons = this->instance->get_horizon_num();
-    fitness_t risk_st;
-    fitness_t risk_t_;
     fitness_t Q_tt;
     fitness_t excess;
     uint_t Qtt_index;
-    array<fitness_t, ARR_SIZE> arr;
-    vector<fitness_t> vec;
-    uint_t risk_in_s_idx = this->instance->get_risk_index(unscheduled_intervention, start_time, start_time);
-    half_fitness_vector_t risk_in_s;
-    for (uint_t t = start_time; t < start_time + this->instance->delta[this->instance->get_delta_index(unscheduled_intervention, start_time)]; ++t) {
+    fitness_t *risk_in_t;
+    /* risk rows of the window are stored one after another, their means do not depend on the solution */
+    const half_fitness_t *risk_in_s = this->instance->risk.data() + descriptor.risk_row;
+    const fitness_t *means = this->instance->get_period_mean_risks(descriptor);
+    this->mean_risk -= descriptor.mean_risk;
+    for (uint_t t = start_time; t < descriptor.end; ++t) {
         scenarios = this->instance->get_scenarios(t);
-        risk_in_s = this->instance->risk[risk_in_s_idx++];
-        for (uint_t s = 1; s <= scenarios; ++s) {
-            risk_st = risk_in_s[TO_INDEX(s)];
-            risk_t_ = (risk_st / scenarios);
-            this->risk_st[t][s] -= risk_st;
-            this->mean_cumulative_risks[t] -= risk_t_;
-            this->mean_risk -= (risk_t_ / horizons);
-        }
-        Qtt_index = ceil(scenarios * this->instance->get_quantile());
-        if (scenarios < ARR_SIZE) {
-            copy(this->risk_st[t].begin(), this->risk_st[t].end(), arr.begin());
-            nth_element(arr.begin(), arr.begin() + Qtt_index, ARR_END_IT(arr.begin(), scenarios));
-            Q_tt = arr[Qtt_index] - this->mean_cumulative_risks[t];
-        } else {
-            vec = this->risk_st[t];
-            nth_element(vec.begin(), vec.begin() + Qtt_index, vec.end());
-            Q_tt = vec[Qtt_index] - this->mean_cumulative_risks[t];
-        }
+        risk_in_t = this->get_risk_st(t);
+        for (uint_t s = 1; s <= scenarios; ++s) risk_in_t[s] -= risk_in_s[TO_INDEX(s)];
+        this->mean_cumulative_risks[t] -= means[t - start_time];
+        Qtt_index = this->instance->get_quantile_index(t);
+        Q_tt = track_quantile(risk_in_t, scenarios + 1, Qtt_index, this->get_quantile_tail(t)) - this->mean_cumulative_risks[t];
         excess = Q_tt < 0 ? 0 : Q_tt;
         this->expected_excess += ((excess - this->expected_excesses[t]) / horizons);
         this->expected_excesses[t] = excess;
+        risk_in_s += scenarios;
     }
     this->final_objective = this->instance->get_alpha() * this->mean_risk + (1 - this->instance->get_alpha()) * this->expected_excess;
 }
 
 void Solution::update_extended_state_on_unschedule(uint unscheduled_intervention, uint_t start_time) {
-    fitness_t before;
-    fitness_t after;
-    fitness_t loss;
-    fitness_t max;
-    fitness_t min;
-    uint_t r_idx;
-    uint_t ul_idx;
-    uint_t end = start_time + this->instance->delta[this->instance->get_delta_index(unscheduled_intervention, start_time)];
-    for (uint_t r : this->instance->get_interventions_resources(unscheduled_intervention)) {
-        r_idx = this->instance->get_r_index(unscheduled_intervention, start_time, r, start_time);
+    const start_descriptor &descriptor = this->instance->get_descriptor(unscheduled_intervention, start_time);
+    const uint_t *resources = this->instance->get_descriptor_resources(descriptor);
+    uint_t r;
+    fitness_t sums[WINDOW_SUMS];
+    ullint_t ul_idx;
+    uint_t end = descriptor.end;
+    /* workload windows of used resources are stored one after another */
+    const half_fitness_t *r_in_t = this->instance->r.data() + descriptor.r_window;
+    for (uint_t position = 0; position < descriptor.resource_count; ++position) {
+        r = resources[position];
         ul_idx = this->instance->get_ul_index(r, start_time);
-        for (uint_t t = start_time; t < end; ++t) {
-            before = this->resource_use[r][t];
-            loss = this->instance->r[r_idx++];
-            after = before - loss;
-            max = this->instance->u[ul_idx];
-            min = this->instance->l[ul_idx++];
-            if (after < min - NUMERIC_TOLERANCE) {
-                if (before < min) {
-                    this->resource_underuse[r] += loss;
-                    this->workload_underuse += loss;
-                } else {
-                    this->resource_underuse[r] += (min - after);
-                    this->workload_underuse += (min - after);
-                }
-            }
-            if (before > max) {
-                if (after > max + NUMERIC_TOLERANCE) {
-                    this->resource_overuse[r] -= loss;
-                    this->resource_overuse[r] = std::max(this->resource_overuse[r], 0.0);
-                    this->workload_overuse -= loss;
-                    this->workload_overuse = std::max(this->workload_overuse, 0.0);
-                } else {
-                    this->resource_overuse[r] -= (before - max);
-                    this->resource_overuse[r] = std::max(this->resource_overuse[r], 0.0);
-                    this->workload_overuse -= (before - max);
-                    this->workload_overuse = std::max(this->workload_overuse, 0.0);
-                }
-            }
-            this->resource_use[r][t] = after;
-            this->total_resource_use -= loss;
-        }
+        fill(sums, sums + WINDOW_SUMS, 0.0);
+        remove_window(this->resource_use.data() + ul_idx, r_in_t, this->instance->u + ul_idx, this->instance->l + ul_idx, end - start_time, sums, this->resource_use.data() + ul_idx);
+        r_in_t += end - start_time;
+        this->resource_underuse[r] += sums[WINDOW_UNDERUSE];
+        this->workload_underuse += sums[WINDOW_UNDERUSE];
+        this->resource_overuse[r] = std::max(this->resource_overuse[r] - sums[WINDOW_OVERUSE], 0.0);
+        this->workload_overuse = std::max(this->workload_overuse - sums[WINDOW_OVERUSE], 0.0);
+        this->total_resource_use -= sums[WINDOW_TOTAL];
     }
     uint_t start2;
     uint_t end2;
-    for (uint_t e : this->instance->get_excluded(unscheduled_intervention)) {
+    uint_t e;
+    for (uint_t item = this->instance->get_exclusion_begin(unscheduled_intervention); item < this->instance->get_exclusion_end(unscheduled_intervention); ++item) {
+        e = this->instance->get_exclusion_partner(item);
         if (this->is_scheduled(e)) {
             start2 = this->start_times[e];
-            end2 = start2 + this->instance->delta[this->instance->get_delta_index(e, start2)];
-            for (uint_t t : this->instance->get_exclusion_season(unscheduled_intervention, e)) {
+            end2 = this->instance->get_descriptor(e, start2).end;
+            for (uint_t t : this->instance->get_season(this->instance->get_exclusion_season_id(item))) {
                 if (
                     t >= start_time && t >= start2 &&
                     t < end && t < end2
@@ -355,48 +1272,23 @@ void Solution::update_extended_state_on_unschedule(uint unscheduled_intervention
 }
 
 void Solution::estimate_state_on_schedule(uint_t scheduled_intervention, uint_t start_time, Objective *objective) {
-    fitness_t mean_risk = this->mean_risk;
+    const start_descriptor &descriptor = this->instance->get_descriptor(scheduled_intervention, start_time);
+    fitness_t mean_risk = this->mean_risk + descriptor.mean_risk;
     fitness_t expected_excess = this->expected_excess;
-    fitness_t risk_st;
-    fitness_t risk_t_;
     uint_t scenarios;
     uint_t horizons = this->instance->get_horizon_num();
-    uint_t Qtt_index;
     fitness_t Qtt;
-    array<fitness_t, ARR_SIZE> arr;
-    vector<fitness_t> vec;
     fitness_t mean_cumulative_risk;
-    uint_t risk_in_s_idx = this->instance->get_risk_index(scheduled_intervention, start_time, start_time);
-    half_fitness_vector_t risk_in_s;
-    for (uint_t t = start_time; t < start_time + this->instance->delta[this->instance->get_delta_index(scheduled_intervention, start_time)]; ++t) {
-        risk_in_s = this->instance->risk[risk_in_s_idx++];
+    /* risk rows of the window are stored one after another */
+    const half_fitness_t *risk_in_s = this->instance->risk.data() + descriptor.risk_row;
+    const fitness_t *means = this->instance->get_period_mean_risks(descriptor);
+    for (uint_t t = start_time; t < descriptor.end; ++t) {
         scenarios = this->instance->get_scenarios(t);
-        mean_cumulative_risk = this->mean_cumulative_risks[t];
-        Qtt_index = ceil(scenarios * this->instance->get_quantile());
-        if (scenarios < ARR_SIZE) {
-            copy(this->risk_st[t].begin(), this->risk_st[t].end(), arr.begin());
-            for (uint_t s = 1; s <= scenarios; ++s) {
-                risk_st = risk_in_s[TO_INDEX(s)];
-                risk_t_ = risk_st / scenarios;
-                arr[s] += risk_st;
-                mean_cumulative_risk += risk_t_;
-                mean_risk += risk_t_ / horizons;
-            }
-            nth_element(arr.begin(), arr.begin() + Qtt_index, ARR_END_IT(arr.begin(), scenarios));
-            Qtt = arr[Qtt_index] - mean_cumulative_risk;
-        } else {
-            vec = this->risk_st[t];
-            for (uint_t s = 1; s <= scenarios; ++s) {
-                risk_st = risk_in_s[TO_INDEX(s)];
-                risk_t_ = risk_st / scenarios;
-                vec[s] += risk_st;
-                mean_cumulative_risk += risk_t_;
-                mean_risk += risk_t_ / horizons;
-            }
-            nth_element(vec.begin(), vec.begin() + Qtt_index, vec.end());
-            Qtt = vec[Qtt_index] - mean_cumulative_risk;
-        }
+        mean_cumulative_risk = this->mean_cumulative_risks[t] + means[t - start_time];
+        /* estimated cumulative risks are written to the kernel's buffer, state stays untouched */
+        Qtt = add_row[this->instance->get_scenario_kernel(t)](this->get_risk_st(t), risk_in_s, scenarios, this->instance->get_quantile_index(t), this->get_quantile_tail(t)) - mean_cumulative_risk;
         expected_excess += (((Qtt > 0 ? Qtt : 0) - this->expected_excesses[t]) / horizons);
+        risk_in_s += scenarios;
     }
     objective->mean_risk = mean_risk;
     objective->expected_excess = expected_excess;
@@ -404,60 +1296,38 @@ void Solution::estimate_state_on_schedule(uint_t scheduled_intervention, uint_t
 }
 
 void Solution::estimate_extended_state_on_schedule(uint scheduled_intervention, uint_t start_time, Objective *objective) {
-    fitness_t before;
-    fitness_t after;
-    fitness_t gain;
-    fitness_t max;
-    fitness_t min;
+    const start_descriptor &descriptor = this->instance->get_descriptor(scheduled_intervention, start_time);
+    const uint_t *resources = this->instance->get_descriptor_resources(descriptor);
+    uint_t r;
+    fitness_t sums[WINDOW_SUMS];
     fitness_t workload_overuse = this->workload_overuse;
     fitness_t workload_underuse = this->workload_underuse;
     fitness_t total_resource_use = this->total_resource_use;
     uint_t exclusion_penalty = this->exclusion_penalty;
-    uint_t r_idx;
-    uint_t ul_idx;
-    uint_t end = start_time + this->instance->delta[this->instance->get_delta_index(scheduled_intervention, start_time)];
-    for (uint_t r : this->instance->get_interventions_resources(scheduled_intervention)) {
-        r_idx = this->instance->get_r_index(scheduled_intervention, start_time, r, start_time);
+    ullint_t ul_idx;
+    uint_t end = descriptor.end;
+    /* workload windows of used resources are stored one after another */
+    const half_fitness_t *r_in_t = this->instance->r.data() + descriptor.r_window;
+    for (uint_t position = 0; position < descriptor.resource_count; ++position) {
+        r = resources[position];
         ul_idx = this->instance->get_ul_index(r, start_time);
-        for (uint_t t = start_time; t < end; ++t) {
-            before = this->resource_use[r][t];
-            gain = this->instance->r[r_idx++];
-            after = before + gain;
-            max = this->instance->u[ul_idx];
-            min = this->instance->l[ul_idx++];
-            if (before < min) {
-                if (after < min - NUMERIC_TOLERANCE) {
-                    workload_underuse -= gain;
-                    workload_underuse = std::max(workload_underuse, 0.0);
-                } else {
-                    workload_underuse -= (min - before);
-                    workload_underuse = std::max(workload_underuse, 0.0);
-                }
-            }
-            if (after > max + NUMERIC_TOLERANCE) {
-                if (before > max) {
-                    workload_overuse += gain;
-                } else {
-                    workload_overuse += (after - max);
-                }
-            }
-            total_resource_use += gain;
-        }
+        fill(sums, sums + WINDOW_SUMS, 0.0);
+        add_window(this->resource_use.data() + ul_idx, r_in_t, this->instance->u + ul_idx, this->instance->l + ul_idx, end - start_time, sums, nullptr);
+        r_in_t += end - start_time;
+        workload_underuse = std::max(workload_underuse - sums[WINDOW_UNDERUSE], 0.0);
+        workload_overuse += sums[WINDOW_OVERUSE];
+        total_resource_use += sums[WINDOW_TOTAL];
     }
     uint_t start2;
     uint_t end2;
-    for (uint_t e : this->instance->get_excluded(scheduled_intervention)) {
+    uint_t e;
+    /* horizons of the season covered by both windows are counted from prefix sums of the season */
+    for (uint_t item = this->instance->get_exclusion_begin(scheduled_intervention); item < this->instance->get_exclusion_end(scheduled_intervention); ++item) {
+        e = this->instance->get_exclusion_partner(item);
         if (this->is_scheduled(e)) {
             start2 = this->start_times[e];
-            end2 = start2 + this->instance->delta[this->instance->get_delta_index(e, start2)];
-            for (uint_t t : this->instance->get_exclusion_season(scheduled_intervention, e)) {
-                if (
-                    t >= start_time && t >= start2 &&
-                    t < end && t < end2
-                ) {
-                    exclusion_penalty++;
-                }
-            }
+            end2 = this->instance->get_descriptor(e, start2).end;
+            exclusion_penalty += this->instance->count_season_overlap(this->instance->get_exclusion_season_id(item), start_time, end, start2, end2);
         }
     }
     objective->total_resource_use = total_resource_use;
@@ -468,48 +1338,23 @@ void Solution::estimate_extended_state_on_schedule(uint scheduled_intervention,
 }
 
 void Solution::estimate_state_on_unschedule(uint_t unscheduled_intervention, uint_t start_time, Objective *objective) {
-    fitness_t mean_risk = this->mean_risk;
+    const start_descriptor &descriptor = this->instance->get_descriptor(unscheduled_intervention, start_time);
+    fitness_t mean_risk = this->mean_risk - descriptor.mean_risk;
     fitness_t expected_excess = this->expected_excess;
-    fitness_t risk_st;
-    fitness_t risk_t_;
     uint_t scenarios;
     uint_t horizons = this->instance->get_horizon_num();
-    uint_t Qtt_index;
     fitness_t Qtt;
-    array<fitness_t, ARR_SIZE> arr;
-    vector<fitness_t> vec;
     fitness_t mean_cumulative_risk;
-    uint_t risk_in_s_idx = this->instance->get_risk_index(unscheduled_intervention, start_time, start_time);
-    half_fitness_vector_t risk_in_s;
-    for (uint_t t = start_time; t < start_time + this->instance->delta[this->instance->get_delta_index(unscheduled_intervention, start_time)]; ++t) {
-        risk_in_s = this->instance->risk[risk_in_s_idx++];
+    /* risk rows of the window are stored one after another */
+    const half_fitness_t *risk_in_s = this->instance->risk.data() + descriptor.risk_row;
+    const fitness_t *means = this->instance->get_period_mean_risks(descriptor);
+    for (uint_t t = start_time; t < descriptor.end; ++t) {
         scenarios = this->instance->get_scenarios(t);
-        mean_cumulative_risk = this->mean_cumulative_risks[t];
-        Qtt_index = ceil(scenarios * this->instance->get_quantile());
-        if (scenarios < ARR_SIZE) {
-            copy(this->risk_st[t].begin(), this->risk_st[t].end(), arr.begin());
-            for (uint_t s = 1; s <= scenarios; ++s) {
-                risk_st = risk_in_s[TO_INDEX(s)];
-                risk_t_ = risk_st / scenarios;
-                arr[s] -= risk_st;
-                mean_cumulative_risk -= risk_t_;
-                mean_risk -= risk_t_ / horizons;
-            }
-            nth_element(arr.begin(), arr.begin() + Qtt_index, ARR_END_IT(arr.begin(), scenarios));
-            Qtt = arr[Qtt_index] - mean_cumulative_risk;
-        } else {
-            vec = this->risk_st[t];
-            for (uint_t s = 1; s <= scenarios; ++s) {
-                risk_st = risk_in_s[TO_INDEX(s)];
-                risk_t_ = risk_st / scenarios;
-                vec[s] -= risk_st;
-                mean_cumulative_risk -= risk_t_;
-                mean_risk -= risk_t_ / horizons;
-            }
-            nth_element(vec.begin(), vec.begin() + Qtt_index, vec.end());
-            Qtt = vec[Qtt_index] - mean_cumulative_risk;
-        }
+        mean_cumulative_risk = this->mean_cumulative_risks[t] - means[t - start_time];
+        /* estimated cumulative risks are written to the kernel's buffer, state stays untouched */
+        Qtt = remove_row[this->instance->get_scenario_kernel(t)](this->get_risk_st(t), risk_in_s, scenarios, this->instance->get_quantile_index(t), this->get_quantile_tail(t)) - mean_cumulative_risk;
         expected_excess += (((Qtt > 0 ? Qtt : 0) - this->expected_excesses[t]) / horizons);
+        risk_in_s += scenarios;
     }
     objective->mean_risk = mean_risk;
     objective->expected_excess = expected_excess;
@@ -517,60 +1362,38 @@ void Solution::estimate_state_on_unschedule(uint_t unscheduled_intervention, uin
 }
 
 void Solution::estimate_extended_state_on_unschedule(uint unscheduled_intervention, uint_t start_time, Objective *objective) {
-    fitness_t before;
-    fitness_t after;
-    fitness_t loss;
-    fitness_t max;
-    fitness_t min;
+    const start_descriptor &descriptor = this->instance->get_descriptor(unscheduled_intervention, start_time);
+    const uint_t *resources = this->instance->get_descriptor_resources(descriptor);
+    uint_t r;
+    fitness_t sums[WINDOW_SUMS];
     fitness_t workload_overuse = this->workload_overuse;
     fitness_t workload_underuse = this->workload_underuse;
     uint_t exclusion_penalty = this->exclusion_penalty;
     fitness_t total_resource_use = this->total_resource_use;
-    uint_t r_idx;
-    uint_t ul_idx;
-    uint_t end = start_time + this->instance->delta[this->instance->get_delta_index(unscheduled_intervention, start_time)];
-    for (uint_t r : this->instance->get_interventions_resources(unscheduled_intervention)) {
-        r_idx = this->instance->get_r_index(unscheduled_intervention, start_time, r, start_time);
+    ullint_t ul_idx;
+    uint_t end = descriptor.end;
+    /* workload windows of used resources are stored one after another */
+    const half_fitness_t *r_in_t = this->instance->r.data() + descriptor.r_window;
+    for (uint_t position = 0; position < descriptor.resource_count; ++position) {
+        r = resources[position];
         ul_idx = this->instance->get_ul_index(r, start_time);
-        for (uint_t t = start_time; t < end; ++t) {
-            before = this->resource_use[r][t];
-            loss = this->instance->r[r_idx++];
-            after = before - loss;
-            max = this->instance->u[ul_idx];
-            min = this->instance->l[ul_idx++];
-            if (after < min - NUMERIC_TOLERANCE) {
-                if (before < min) {
-                    workload_underuse += loss;
-                } else {
-                    workload_underuse += (min - after);
-                }
-            }
-            if (before > max) {
-                if (after > max + NUMERIC_TOLERANCE) {
-                    workload_overuse -= loss;
-                    workload_overuse = std::max(workload_overuse, 0.0);
-                } else {
-                    workload_overuse -= (before - max);
-                    workload_overuse = std::max(workload_overuse, 0.0);
-                }
-            }
-            total_resource_use -= loss;
-        }
+        fill(sums, sums + WINDOW_SUMS, 0.0);
+        remove_window(this->resource_use.data() + ul_idx, r_in_t, this->instance->u + ul_idx, this->instance->l + ul_idx, end - start_time, sums, nullptr);
+        r_in_t += end - start_time;
+        workload_underuse += sums[WINDOW_UNDERUSE];
+        workload_overuse = std::max(workload_overuse - sums[WINDOW_OVERUSE], 0.0);
+        total_resource_use -= sums[WINDOW_TOTAL];
     }
     uint_t start2;
     uint_t end2;
-    for (uint_t e : this->instance->get_excluded(unscheduled_intervention)) {
+    uint_t e;
+    /* horizons of the season covered by both windows are counted from prefix sums of the season */
+    for (uint_t item = this->instance->get_exclusion_begin(unscheduled_intervention); item < this->instance->get_exclusion_end(unscheduled_intervention); ++item) {
+        e = this->instance->get_exclusion_partner(item);
         if (this->is_scheduled(e)) {
             start2 = this->start_times[e];
-            end2 = start2 + this->instance->delta[this->instance->get_delta_index(e, start2)];
-            for (uint_t t : this->instance->get_exclusion_season(unscheduled_intervention, e)) {
-                if (
-                    t >= start_time && t >= start2 &&
-                    t < end && t < end2
-                ) {
-                    exclusion_penalty--;
-                }
-            }
+            end2 = this->instance->get_descriptor(e, start2).end;
+            exclusion_penalty -= this->instance->count_season_overlap(this->instance->get_exclusion_season_id(item), start_time, end, start2, end2);
         }
     }
     objective->total_resource_use = total_resource_use;
@@ -581,8 +1404,8 @@ void Solution::estimate_extended_state_on_unschedule(uint unscheduled_interventi
 }
 
 void Solution::print() {
-    for (uint_to_uint_t::iterator it = this->start_times.begin(); it != this->start_times.end(); ++it) {
-        cout << this->instance->get_intervention(it->first) << " -> " << it->second << endl;
+    for (uint_t intervention : this->scheduled) {
+        cout << this->instance->get_intervention(intervention) << " -> " << this->start_times[intervention] << endl;
     }
 }
 
@@ -682,8 +1505,8 @@ void Solution::print_unscheduled_cnt() {
 
 bool Solution::undefined_intervention() {
     bool ret = CORRECT;
-    for (uint_to_uint_t::iterator iter = this->start_times.begin(); iter != this->start_times.end(); ++iter) {
-        if (find(this->instance->get_interventions().begin(), this->instance->get_interventions().end(), iter->first) == this->instance->get_interventions().end()) {
+    for (uint_t intervention : this->scheduled) {
+        if (find(this->instance->get_interventions().begin(), this->instance->get_interventions().end(), intervention) == this->instance->get_interventions().end()) {
             ret = ERROR;
             this->throw_message(ret, "Undefined intervention", "intervention in solution is not present int instance dataset");
             break;
@@ -696,7 +1519,7 @@ bool Solution::undefined_intervention() {
 bool Solution::unscheduled_intervention() {
     bool ret = CORRECT;
     for (uint_t intervention : this->instance->get_interventions()) {
-        if (this->start_times.find(intervention) == this->start_times.end()) {
+        if (!this->is_scheduled(intervention)) {
             ret = ERROR;
             this->throw_message(ret, "Unscheduled intervention", this->instance->get_intervention(intervention));
             break;
@@ -708,10 +1531,10 @@ bool Solution::unscheduled_intervention() {
 
 bool Solution::start_time_out_of_range() {
     bool ret = CORRECT;
-    for (uint_to_uint_t::iterator iter = this->start_times.begin(); iter != this->start_times.end(); ++iter) {
-        if (iter->second < 1 || iter->second > this->instance->get_horizon_num()) {
+    for (uint_t intervention : this->scheduled) {
+        if (this->start_times[intervention] < 1 || this->start_times[intervention] > this->instance->get_horizon_num()) {
             ret = ERROR;
-            this->throw_message(ret, "Start time out of range", this->time_bounds_details(this->instance->get_intervention(iter->first), iter->second, this->instance->get_horizon_num()));
+            this->throw_message(ret, "Start time out of range", this->time_bounds_details(this->instance->get_intervention(intervention), this->start_times[intervention], this->instance->get_horizon_num()));
             break;
         }
     }
@@ -721,10 +1544,10 @@ bool Solution::start_time_out_of_range() {
 
 bool Solution::start_time_out_of_intervention_range() {
     bool ret = CORRECT;
-    for (uint_to_uint_t::iterator iter = this->start_times.begin(); iter != this->start_times.end(); ++iter) {
-        if (iter->second > this->instance->get_t_max(iter->first)) {
+    for (uint_t intervention : this->scheduled) {
+        if (this->start_times[intervention] > this->instance->get_t_max(intervention)) {
             ret = ERROR;
-            this->throw_message(ret, "", this->intervention_time_bounds_details(this->instance->get_intervention(iter->first), iter->second, this->instance->get_t_max(iter->first)));
+            this->throw_message(ret, "", this->intervention_time_bounds_details(this->instance->get_intervention(intervention), this->start_times[intervention], this->instance->get_t_max(intervention)));
             break;
         }
     }
@@ -739,8 +1562,8 @@ bool Solution::resource_out_of_bounds() {
         for (uint_t time : this->instance->get_horizons()) {
             workload = 0;
             /* sum workload of current resource in current time used on all interventions */
-            for (uint_to_uint_t::iterator iter = this->start_times.begin(); iter != this->start_times.end(); ++iter) {
-                workload += this->instance->r[this->instance->get_r_index(iter->first, iter->second, resource, time)];
+            for (uint_t intervention : this->scheduled) {
+                workload += this->instance->get_r(intervention, this->start_times[intervention], resource, time);
             }
             /* check upper bound */
             if (workload > this->instance->u[this->instance->get_ul_index(resource, time)] + NUMERIC_TOLERANCE) {
@@ -770,8 +1593,8 @@ bool Solution::unmet_exclusion() {
     for (const uint_pair_t &exclusion : this->instance->get_exclusion_pairs()) {
         /* check if interventions from exclusion were already scheduled */
         if (
-            this->start_times.find(exclusion.first) == this->start_times.end() ||
-            this->start_times.find(exclusion.second) == this->start_times.end()
+            !this->is_scheduled(exclusion.first) ||
+            !this->is_scheduled(exclusion.second)
         ) continue;
         /* load parameters of the two checked interventions */
         i1_start = this->start_times[exclusion.first];
@@ -798,6 +1621,7 @@ bool Solution::unmet_exclusion() {
 }
 
 void Solution::compute_objectives() {
+    this->touch();
     fitness_t mean_risk = 0.0; /* sum of mean risks in all times */
     fitness_t mean_risk_in_time; /* help variable to store mean risk in current time */
     fitness_t temp; /* help variable to hold values which are used on multiple places to avoid computing the same thing */
@@ -813,10 +1637,11 @@ void Solution::compute_objectives() {
         mean_risk_in_time = 0.0;
         fill(quantile_in_time.begin(), quantile_in_time.end(), 0.0); /* reset quantiles from previous time */
         scenarios_in_time = this->instance->get_scenarios(time);
-        for (uint_pair_t items : this->start_times) { /* item corresponds to pair <intervention, start_time> */
-            if (time >= items.second && time < (items.second + this->instance->delta[this->instance->get_delta_index(items.first, items.second)])) {
+        for (uint_t intervention : this->scheduled) {
+            uint_t start = this->start_times[intervention];
+            if (time >= start && time < (this->instance->get_descriptor(intervention, start).end)) {
                 for (uint_t scenario = 1; scenario <= scenarios_in_time; ++scenario) {
-                    temp = this->instance->risk[this->instance->get_risk_index(items.first, items.second, time)][TO_INDEX(scenario)];
+                    temp = this->instance->risk[this->instance->get_risk_index(intervention, start, time) + TO_INDEX(scenario)];
                     mean_risk_in_time += temp;
                     quantile_in_time[scenario - 1] += temp;
                 }
@@ -843,6 +1668,7 @@ void Solution::compute_final_objective() {
 }
 
 void Solution::compute_workload_misuse() {
+    this->touch();
     fitness_t workload_ct;
     this->workload_underuse = 0.0;
     this->workload_overuse = 0.0;
@@ -853,8 +1679,8 @@ void Solution::compute_workload_misuse() {
         // this->resource_usage[resource] = 0.0;
         for (uint_t time : this->instance->get_horizons()) {
             workload_ct = 0.0;
-            for (uint_to_uint_t::iterator it = this->start_times.begin(); it != this->start_times.end(); ++it) {
-                workload_ct += this->instance->r[this->instance->get_r_index(it->first, it->second, resource, time)];
+            for (uint_t intervention : this->scheduled) {
+                workload_ct += this->instance->get_r(intervention, this->start_times[intervention], resource, time);
             }
             fitness_t max = this->instance->u[this->instance->get_ul_index(resource, time)];
             fitness_t min = this->instance->l[this->instance->get_ul_index(resource, time)];
@@ -876,6 +1702,7 @@ void Solution::compute_workload_misuse() {
 }
 
 void Solution::count_unmet_exclusions() {
+    this->touch();
     fill(this->exclusions_at_time.begin(), this->exclusions_at_time.end(), 0);
     this->exclusion_penalty = 0;
     uint_t i1_start;
@@ -885,8 +1712,8 @@ void Solution::count_unmet_exclusions() {
     for (const uint_pair_t &exclusion : this->instance->get_exclusion_pairs()) {
         /* check if interventions from exclusion were already scheduled */
         if (
-            this->start_times.find(exclusion.first) == this->start_times.end() ||
-            this->start_times.find(exclusion.second) == this->start_times.end()
+            !this->is_scheduled(exclusion.first) ||
+            !this->is_scheduled(exclusion.second)
         ) continue;
         /* load parameters of the two checked interventions */
         i1_start = this->start_times[exclusion.first];
@@ -914,7 +1741,6 @@ void Solution::compute_extended_objective() {
 
 void Solution::generate_random_solution() {
     /* init random generator */
-    this->start_times.clear();
     random_device random;
     mt19937 gen(random());
     uniform_int_distribution<> range(1, this->instance->get_horizon_num());
@@ -925,6 +1751,7 @@ void Solution::generate_random_solution() {
 }
 
 void Solution::round_up(int digits) {
+    this->touch();
     this->workload_overuse = floor(pow(10, digits) * this->workload_overuse + 0.5)/pow(10, digits);
     this->workload_underuse = floor(pow(10, digits) * this->workload_underuse + 0.5)/pow(10, digits);
     this->compute_extended_objective();
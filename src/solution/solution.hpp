@@ -3,13 +3,20 @@
 
 #include <vector>
 #include <array>
+#include <utility>
 #include <unordered_set>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <algorithm>
+#include <numeric>
 #include <random>
+#include <atomic>
+#include <type_traits>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 #include "../types.hpp"
 #include "../util.hpp"
 #include "../instance/instance.hpp"
@@ -22,15 +29,28 @@
 #define LOWER false
 
 #define SCHEDULE_ERR 100
-
-// size of the array for finding nth_element -> needs to be >= max number of scenarios
-#define ARR_SIZE 512
-
-// iterator + sizeof array + 1
-#define ARR_END_IT(X, Y) (X + Y + 1)
+/* order of objective parts in arrays of changes caused in horizons */
+#define CHANGE_MEAN_RISK 0
+#define CHANGE_EXPECTED_EXCESS 1
+#define CHANGE_UNDERUSE 2 /* decrease of underuse */
+#define CHANGE_OVERUSE 3
+#define CHANGE_RESOURCE_USE 4
+#define CHANGE_EXCLUSIONS 5
+#define CHANGES 6
+#define QUANTILE_TAIL 4 /* how many times more scenarios than needed are kept to bound the quantile */
+/* items of schedule cache hold CHANGES parts followed by validity flag */
+#define CACHE_VALID CHANGES
+#define CACHE_ITEM (CHANGES + 1)
 
 using namespace std;
 
+/* (un)scheduling of intervention kept in undo trail, 0 stands for unscheduled */
+struct trail_record {
+    uint_t intervention;
+    uint_t old_start;
+    uint_t new_start;
+};
+
 class Solution {
     private:
         void throw_message(const bool correct, const string &label, const string &message);
@@ -38,24 +58,50 @@ class Solution {
         string intervention_time_bounds_details(const string &item, const uint_t start_time, const uint_t bound);
         string workload_bounds_details(const bool upper, const string &item, const uint_t horizon, const fitness_t value, const uint_t bound);
         string exclusion_details(const string &first, const string &second, const uint_t horizon);
-        uint_to_uint_t start_times; /* map that holds the solution <intervention, start_time> */
+        void horizon_change(uint_t horizon, const uint_t *interventions, const uint_t *old_starts, const uint_t *new_starts, uint_t count, bool risk, bool workload, fitness_t *change);
+        void sum_horizon_changes(uint_t intervention, bool risk, bool workload, uint_t skip_start, uint_t skip_end, fitness_t *sums);
+        void count_exclusions(uint_t intervention, fitness_t *counts, uint_t ignored);
+        void fill_objective(const fitness_t *changes, Objective *objective);
+        void cache_changes(const Objective &objective, fitness_t *item);
+        void invalidate_cache(uint_t intervention, uint_t start_time); /* marks cached start times whose windows overlap the window as invalid */
+        uint_vector_t start_times; /* start time of each intervention indexed by id, 0 when unscheduled */
+        uint_vector_t tail_offsets; /* offsets of tails of horizons into quantile_tails */
+        static atomic<ullint_t> versions; /* source of state versions unique among all solutions */
+        void touch(); /* marks change of state variables */
+
+        /*
+         * undo trail kept between checkpoint and rollback, records of (un)scheduling in order they were done,
+         * state cells of each horizon are saved before its first change, per resource and scalar state as a whole at checkpoint
+         */
+        bool trailing = false;
+        vector<trail_record> trail;
+        vector<bool> trailed; /* horizons whose cells are saved */
+        uint_vector_t trailed_horizons;
+        vector<fitness_t> trail_cells; /* risk_st row, mean cumulative risk, expected excess, exclusions and resource uses of each horizon */
+        uint_vector_t trail_tails;
+        vector<fitness_t> trail_underuse;
+        vector<fitness_t> trail_overuse;
+        uint_vector_t trail_unscheduled_cnt;
+        Objective trail_objective;
+        void save_window(uint_t intervention, uint_t old_start, uint_t new_start); /* records (un)scheduling and saves cells of its window */
     public:
         Instance *instance;
         std::default_random_engine *engine;
-        set<uint_t> unscheduled; /* set that holds interventions not yet scheduled */
-        set<uint_t> scheduled; /* set that holds interventions already scheduled */
+        uint_vector_t unscheduled; /* ascending ids of interventions not yet scheduled */
+        uint_vector_t scheduled; /* ascending ids of interventions already scheduled */
 
         /* mean risk intermediate results */
         vector<fitness_t> mean_cumulative_risks;
         /* quantile intermediate results */
-        vector<vector<fitness_t>> risk_st; /* cumulative risks [t][s] */
+        vector<fitness_t> risk_st; /* cumulative risks [t][s] in rows of scenarios + 1 items, see get_risk_st */
+        uint_vector_t quantile_tails; /* scenarios [t][] with cumulative risks beyond the quantile, kept by (un)schedule */
         vector<fitness_t> expected_excesses;
         /* objective functions of the solution */
         fitness_t mean_risk;
         fitness_t expected_excess;
         fitness_t final_objective;
 
-        vector<vector<fitness_t>> resource_use; /* tracks use of resource in time [resource][time] */
+        vector<fitness_t> resource_use; /* tracks use of resource in time [resource][time], indexed as instance bounds */
 
         vector<fitness_t> resource_underuse; /* sum of under lower bound values for each resource */
         fitness_t workload_underuse; /* sum of all workloads under lower bounds */
@@ -73,6 +119,16 @@ class Solution {
 
         fitness_t extended_objective; /* objective that takes in account number of unmet exclusions and workload out of bounds */
 
+        ullint_t version = 0; /* changes with state variables, copies share it until they diverge */
+
+        /*
+         * changes of objective parts caused by scheduling unscheduled interventions, [i][t][item] with items of CACHE_ITEM values,
+         * empty for interventions that are not cached, the cache follows the state only while cache_version matches version
+         */
+        vector<vector<fitness_t>> schedule_cache;
+        uint_vector_t cached_interventions;
+        ullint_t cache_version = 0;
+
         uint_t restarts_cnt;
         vector<uint_t> unscheduled_cnt; /* counter of interventions unscheduling */
 
@@ -87,11 +143,32 @@ class Solution {
         uint_t get_first_unscheduled();
         void save(string output_file_path);
 
+        /* undo trail, state after checkpoint is changed only by (un)scheduling until rollback or release */
+        void checkpoint(); /* starts recording changes from current state, drops older records */
+        void rollback(); /* restores state of the last checkpoint and keeps recording from it */
+        void release(); /* stops recording */
+        void follow(const Solution &source); /* applies changes of source since its checkpoint, state has to equal the checkpoint */
+
         /* simple validity check from state variables */
         bool is_valid();
 
+        /* cumulative risks of scenarios in horizon indexed from 1, tail of scenarios beyond the quantile in horizon */
+        fitness_t *get_risk_st(uint_t horizon);
+        uint_t *get_quantile_tail(uint_t horizon);
+
         Objective estimate_schedule(uint_t intervention_id, uint_t start_time);
         Objective estimate_unschedule(uint_t intervention_id);
+        /* estimates of all start times of unscheduled intervention in one pass, objectives[t] for start time t */
+        void estimate_schedule_times(uint_t intervention_id, vector<Objective> &objectives);
+        /* same as estimate_schedule_times, start times not affected by (un)scheduling since the last call are taken from the cache */
+        void estimate_schedule_times_cached(uint_t intervention_id, vector<Objective> &objectives);
+        void prepare_cache(); /* drops cache not following the state, cached estimates of different interventions may then run in parallel */
+        /* read-only estimates of moving scheduled intervention from its start time to another one */
+        Objective estimate_move(uint_t intervention_id, uint_t start_time);
+        void estimate_move_times(uint_t intervention_id, vector<Objective> &objectives);
+        void estimate_two_move_times(uint_t i1, uint_t t1, uint_t i2, vector<Objective> &objectives);
+        /* read-only estimate of moving interventions from old to new start times, 0 stands for unscheduled */
+        Objective estimate_moves(const uint_t *interventions, const uint_t *old_starts, const uint_t *new_starts, uint_t count);
 
         /* -- methods that update state variables based on (un)scheduled intervnetion */
         void update_state_on_schedule(uint_t scheduled_intervention, uint_t start_time);
@@ -10,7 +10,11 @@ typedef unsigned int uint_t;
 typedef unsigned long int ulint_t;
 typedef unsigned long long int ullint_t;
 typedef double fitness_t; /* change to float or long double to affect performance or precision */
+#ifdef REDUCED_PRECISION
+typedef float half_fitness_t; /* storage of risks and workloads, accumulators of solutions stay fitness_t */
+#else
 typedef double half_fitness_t;
+#endif
 typedef std::tuple<fitness_t, uint_t, uint_t> tuple_t;
 
 #endif